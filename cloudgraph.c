@@ -3,17 +3,364 @@
 // ================= Include ==================
 
 #include "cloudgraph.h"
+#include <limits.h>
+#include <float.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <time.h>
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CLOUDGRAPH_SIMDX86
+#include <immintrin.h>
+#endif
 
 // ================= Define ==================
 
 #define rnd() (float)(rand())/(float)(RAND_MAX)
 #define CLOUDGRAPH_MAXLENGTHLABEL 500
+#define CLOUDGRAPH_BINMAGIC "CGBF"
+#define CLOUDGRAPH_BINSIZEHEADER 32
+#define CLOUDGRAPH_BINSIZEFAMILY 12
+#define CLOUDGRAPH_BINSIZENODE 12
+#define CLOUDGRAPH_BINNOLABEL 0xFFFFFFFF
+// Upper bound (excluded) of the IDs in a binary file, keeps the 
+// indexes of IDs far from the overflow of their capacity
+#define CLOUDGRAPH_BINMAXID ((uint32_t)(INT_MAX / 2))
+#define CLOUDGRAPH_MINLINKPERTHREAD 10000
+// Maximum number of threads arranging a CloudGraph
+#define CLOUDGRAPH_MAXTHREAD 64
+// Minimum number of nodes or links per thread arranging a CloudGraph
+#define CLOUDGRAPH_MINARRANGEPERTHREAD 10000
+// Parameters of the free layout
+// Ideal length of the links, relative to the node font size
+#define CLOUDGRAPH_FREELENGTH 3.0
+// Strength of the repulsion between nodes
+#define CLOUDGRAPH_FREEREPULSION 0.2
+// Strength of the attraction toward the center of the graph, keeping
+// the disconnected parts together
+#define CLOUDGRAPH_FREEGRAVITY 0.05
+// Barnes-Hut criterion, a cell of the quadtree is used as one mass if 
+// its size over its distance is below it
+#define CLOUDGRAPH_FREETHETA 1.2
+// Factor of the step of the nodes when the energy doesn't decrease, 
+// and number of decreases after which the step grows again
+#define CLOUDGRAPH_FREECOOLING 0.9
+#define CLOUDGRAPH_FREEPROGRESS 5
+// The layout has converged when the average move of the nodes is 
+// below this ratio of the ideal length of the links
+#define CLOUDGRAPH_FREETOLERANCE 0.01
+// Maximum depth of the quadtree, nodes closer than its smallest cells
+// share a cell
+#define CLOUDGRAPH_QUADMAXDEPTH 32
+// Number of nodes in circle mode after which the angle recurrence is 
+// restarted from an exact cos/sin, to bound its drift
+#define CLOUDGRAPH_ANGLERESYNC 64
+#define CLOUDGRAPH_FNVOFFSET 14695981039346656037ULL
+#define CLOUDGRAPH_FNVPRIME 1099511628211ULL
+#define CLOUDGRAPH_MAXLENGTHPATH 1024
+#define CLOUDGRAPH_LAYOUTMAGIC "CGLC"
+#define CLOUDGRAPH_LAYOUTVERSION 1
+// Number of floats per element in the layout cache files
+// Bounding box of the cloud: pos, axis
+#define CLOUDGRAPH_SIZELAYOUTBOX 6
+// Node: id, pos, right, theta, bounding box, bounding box of the label
+#define CLOUDGRAPH_SIZELAYOUTNODE 18
+// Link: control points, families, bounding box
+#define CLOUDGRAPH_SIZELAYOUTLINK 16
+// Family: pos, right, bounding box of the label
+#define CLOUDGRAPH_SIZELAYOUTFAMILY 10
+// Alignment in bytes of the allocations in the arena
+#define CLOUDGRAPH_ARENAALIGN 16
+// Size in bytes of the first block of the arena and maximum size of
+// the following blocks, the size doubles from one block to the next
+#define CLOUDGRAPH_ARENASIZEBLOCK 65536
+#define CLOUDGRAPH_ARENAMAXSIZEBLOCK 16777216
+// Size in bytes of the header of the blocks, rounded to the alignment
+#define CLOUDGRAPH_ARENASIZEHEADER \
+  ((sizeof(CloudGraphArenaBlock) + CLOUDGRAPH_ARENAALIGN - 1) / \
+  CLOUDGRAPH_ARENAALIGN * CLOUDGRAPH_ARENAALIGN)
+// Minimum number of slots of the set of links
+#define CLOUDGRAPH_LINKSETMINCAPACITY 64
+// Multiplier of the hash of the pairs of nodes in the set of links
+#define CLOUDGRAPH_LINKSETHASH 0x9E3779B97F4A7C15ULL
+// Minimum alpha of the links when their opacity shows their weight
+#define CLOUDGRAPH_MINLINKALPHA 32
+// Size in pixels of the tiles rendered in parallel by CloudGraphToTGA
+// if the tiled rendering is enabled (see CloudGraphOptSetTiledRender)
+#define CLOUDGRAPH_TILESIZE 256
+// Number of times a link is split in halves to find the tiles it 
+// crosses
+#define CLOUDGRAPH_RENDERSPLITDEPTH 4
+// Number of subpixel positions along each axis at which the disc of 
+// the nodes is rasterized once and then copied
+#define CLOUDGRAPH_SPRITEPHASE 4
+// Distance in pixels from their chord below which the pieces of a 
+// link are flattened into a segment in density mode, and maximum 
+// number of times a link is split in halves
+#define CLOUDGRAPH_DENSITYFLATNESS 0.5
+#define CLOUDGRAPH_DENSITYMAXDEPTH 16
+// Greatest number of links counted on a pixel in density mode, so that
+// the sum of their colors fits in an unsigned int
+#define CLOUDGRAPH_DENSITYMAXCOUNT (UINT_MAX / 255)
+
+// ================= Data structures ===================
+
+// Kernel setting the intermediate control points of the links at 
+// positions 'first' to 'last' - 1 in the columns 'cols' as 
+// CloudGraphArrangeLink with 'curvature'
+// All the kernels give exactly the same result as CloudGraphArrangeLink
+typedef void (*CloudGraphArrangeLinksKernel)(CloudGraphColumns *cols, 
+  int first, int last, float curvature);
+
+// Cell of the quadtree of the free layout
+typedef struct CloudGraphQuad {
+  // Center of mass and number of the nodes in the cell
+  float _x;
+  float _y;
+  float _mass;
+  // Center and half size of the cell
+  float _cx;
+  float _cy;
+  float _half;
+  // Position in the quadtree of the first of the 4 sub-cells, -1 if 
+  // the cell is a leaf
+  int _child;
+  // Node of a leaf, -1 if empty, -2 if several nodes share the leaf
+  int _body;
+} CloudGraphQuad;
+
+// State of the free layout, see CloudGraphArrangeFree
+typedef struct CloudGraphFreeLayout {
+  // Ideal length of the links
+  float _length;
+  // Strength of the attraction toward the family center
+  float _familyForce;
+  // Cells of the quadtree, its number and allocated size
+  CloudGraphQuad *_quads;
+  int _nbQuad;
+  int _capacityQuad;
+  // Position in the quadtree of the leaf holding each node
+  int *_leaf;
+  // Nodes in the order of the quadtree, so that the nodes processed 
+  // one after the other are close and visit the same cells
+  int *_order;
+  // Rank of the cells in the order of the quadtree, and counts to sort
+  // the nodes by rank of their leaf (_capacityQuad + 1 int each)
+  int *_rank;
+  int *_count;
+  // Force on each node
+  float *_forceX;
+  float *_forceY;
+  // Center of each family (indexed by CloudGraphFamilyKey), and its 
+  // number of nodes
+  float *_familyX;
+  float *_familyY;
+  int *_familyNb;
+  // Center of the graph
+  float _centerX;
+  float _centerY;
+} CloudGraphFreeLayout;
+
+// Coverage mask of a glyph rasterized at one rotation, see 
+// CloudGraphGetGlyph, or of the disc of the nodes, see 
+// CloudGraphRenderSprites
+typedef struct CloudGraphGlyph {
+  // Flag set once the glyph has been rasterized
+  bool _done;
+  // Coverage of the pixels of the mask, from 0 (empty) to 255, NULL if
+  // the glyph is empty
+  unsigned char *_mask;
+  // Dimensions of the mask, and position of its first pixel relative 
+  // to the pixel where the glyph is printed
+  int _dim[2];
+  int _origin[2];
+} CloudGraphGlyph;
+
+// State of the rendering of a CloudGraph into a TGA, tile by tile, 
+// see CloudGraphToTGA
+// The elements drawn are numbered in the order they are drawn: the 
+// nodes (with their label) in the order of the columns, then the 
+// links in the order of the columns, then the labels of the families 
+// in the order of their list
+typedef struct CloudGraphRender {
+  // CloudGraph, options and view of the rendering
+  const CloudGraph *_cloud;
+  const CloudGraphOpt *_opt;
+  CloudGraphView _view;
+  // Rendered TGA and the color of its background
+  TGA *_tga;
+  TGAPixel *_background;
+  // Number of tiles along each dimension, and their size in pixels,
+  // one tile covering the whole TGA if it is not rendered in tiles
+  int _nbTile[2];
+  int _sizeTile[2];
+  // Number of nodes, links and families
+  int _nbNode;
+  int _nbLink;
+  int _nbFamily;
+  // Families in the order of their list
+  CloudGraphFamily **_families;
+  // Flags memorizing the empty families, indexed by family ID
+  bool *_emptyFamily;
+  // Colors of the pencil while drawing each link (2 rgba per link), 
+  // and flags memorizing which of the 2 colors have been set (bit 0 
+  // and 1), as they would be if all the elements were drawn in order
+  unsigned char *_linkRgba;
+  unsigned char *_linkRgbaSet;
+  // Thickness of the pencil for the labels of the families
+  float _familyThickness;
+  // Disc of the nodes rasterized at each subpixel position, NULL if 
+  // the nodes are drawn with the pencil
+  CloudGraphGlyph *_sprites;
+  // Greatest number of links crossing a pixel in density mode
+  unsigned int _maxCount;
+  // Elements drawn on each tile, in the order they are drawn: the 
+  // elements of the tile 'iTile' are _elems[_offsets[iTile]] to 
+  // _elems[_offsets[iTile + 1] - 1]
+  int *_offsets;
+  int *_elems;
+  // Position of the next element of each tile while binning, and 
+  // last element binned in each tile
+  int *_cursor;
+  int *_mark;
+} CloudGraphRender;
+
+// Atlas of the glyphs of the node labels, rasterized on first use at 
+// each rotation, see CloudGraphPrintLabel
+typedef struct CloudGraphGlyphAtlas {
+  // Number of rotations, size of the font and thickness of the pencil
+  int _nbRotation;
+  float _size;
+  float _thickness;
+  // Advance of the characters along the right direction of the label,
+  // negative if not calculated yet
+  float _advance[256];
+  // Glyphs of each character at each rotation, NULL if the character 
+  // hasn't been used yet
+  CloudGraphGlyph *_glyphs[256];
+  // Font and pencil used to rasterize the glyphs
+  TGAFont *_font;
+  TGAPencil *_pen;
+} CloudGraphGlyphAtlas;
+
+// Tools of a thread rendering tiles, see CloudGraphRenderTask
+typedef struct CloudGraphRenderWorker {
+  // TGA of the current tile, its dimensions, and position of the tile
+  // in the TGA
+  TGA *_tile;
+  int _dim[2];
+  VecFloat *_offset;
+  // Font, pencil and curve used to draw
+  TGAFont *_font;
+  TGAPencil *_pen;
+  BCurve *_curve;
+  // Position, right direction of the labels and size while drawing, 
+  // and pixel while copying masks
+  VecFloat *_pos;
+  VecFloat *_right;
+  VecFloat *_sizeNode;
+  VecShort *_pix;
+  // Atlas of the glyphs of the node labels, used if its number of 
+  // rotations is not 0
+  CloudGraphGlyphAtlas _atlas;
+  // Number of links crossing each pixel of the tile and sum of their 
+  // colors (rgb), NULL if the links are drawn as curves
+  unsigned int *_count;
+  unsigned int *_sum;
+} CloudGraphRenderWorker;
+
+// Range of nodes and links processed by one thread while arranging a
+// CloudGraph, see CloudGraphRunTasks
+typedef struct CloudGraphRangeTask {
+  // CloudGraph and options of the arrangement
+  CloudGraph *_cloud;
+  CloudGraphOpt *_opt;
+  // Positions in the columns of the first node and after the last node
+  // of the range
+  int _firstNode;
+  int _lastNode;
+  // Positions in the columns of the first link and after the last link
+  // of the range
+  int _firstLink;
+  int _lastLink;
+  // Kernel and curvature to set the control points of the links
+  CloudGraphArrangeLinksKernel _kernel;
+  float _curvature;
+  // Bounds of the nodes and links of the range
+  float _min[2];
+  float _max[2];
+  // State of the free layout
+  CloudGraphFreeLayout *_free;
+  // Rendering, and tiles rendered by the task: _firstTile, 
+  // _firstTile + _stepTile, ...
+  CloudGraphRender *_render;
+  int _firstTile;
+  int _stepTile;
+  // Greatest number of links crossing a pixel of the tiles of the task
+  // in density mode
+  unsigned int _maxCount;
+  // Flag set if the task succeeded
+  bool _success;
+} CloudGraphRangeTask;
+
+// Chunk of the links section parsed by one thread in 
+// CloudGraphLoadLinksParallel
+typedef struct CloudGraphLinkChunk {
+  // Data of the chunk
+  char *_start;
+  char *_end;
+  // Number of nodes, to check the node IDs
+  int _nbNode;
+  // Pairs of node IDs, 2 per link
+  int *_pairs;
+  // Number of pairs
+  int _nbPair;
+  // Flag set if the parsing stopped on invalid data
+  bool _failed;
+  // Flag set if the parsing stopped on a memory allocation failure
+  bool _noMem;
+} CloudGraphLinkChunk;
+
+// Block of memory of the arena of a CloudGraph, the data of the block
+// follows its header
+typedef struct CloudGraphArenaBlock {
+  // Previous block, the head of the arena is the most recent block
+  struct CloudGraphArenaBlock *_next;
+  // Size in bytes of the data of the block
+  size_t _size;
+  // Number of bytes of the data already allocated
+  size_t _used;
+} CloudGraphArenaBlock;
 
 // ================ Functions declaration ====================
 
-// Sort the nodes in the GSet in order of their families 
-// Do nothing if arguments are invalid
-void CloudGraphSortNodeByFamily(CloudGraph *cloud);
+// Sort the nodes in the GSet in order of their families, and inside
+// a family in the order 'opt->_nodeOrder'
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphSortNodeByFamily(CloudGraph *cloud, CloudGraphOpt *opt);
+
+// Sort stably the 'nb' elements 'elem' into 'sorted' by increasing 
+// 'key' in [0, 'nbKey'[, 'key' and 'count' ('nbKey' + 1 int) are 
+// indexed like 'elem' and used as temporary memory
+void CloudGraphCountingSort(GSetElem **elem, GSetElem **sorted, 
+  int *key, int nb, int *count, int nbKey);
+
+// Merge the nodes out of the order of their families in the GSet with
+// the nodes in order, as CloudGraphSortNodeByFamily with 
+// CloudGraphOptNodeOrderNone, sorting only the nodes out of order
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphMergeNodeByFamily(CloudGraph *cloud);
+
+// Set the position of the nodes and the control points of the links 
+// in the columns of 'cloud' according to 'opt->_mode', copy them to 
+// the nodes and links and update the bounding boxes
+// Return true if it could arrange nodes
+// Return false if it couldn't arrange nodes
+bool CloudGraphArrangeNodes(CloudGraph *cloud, CloudGraphOpt *opt);
 
 // Arrange the position of the nodes of the graph in line
 // Return true if it could arrange nodes
@@ -25,11 +372,635 @@ bool CloudGraphArrangeLine(CloudGraph *cloud, CloudGraphOpt *opt);
 // Return false if arguments are invalid or it couldn't arrange nodes
 bool CloudGraphArrangeCircle(CloudGraph *cloud, CloudGraphOpt *opt);
 
+// Arrange the position of the nodes of the graph with a 
+// force-directed layout
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeFree(CloudGraph *cloud, CloudGraphOpt *opt);
+
+// Arrange the position of the nodes of the graph on rings, the 
+// families on an outer ring and their nodes on concentric rings 
+// inside them, within the maximum canvas of 'opt'
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeRings(CloudGraph *cloud, CloudGraphOpt *opt);
+
+// Return the number of nodes on the ring 'iRing' of a family in rings 
+// mode, the ring 0 being the center of the family
+int CloudGraphRingCapacity(int iRing);
+
+// Return the scale of the distances between nodes in rings mode for 
+// a layout at 'extent' from the center, such as the TGA including the
+// labels fits in 'opt->_maxCanvas'
+float CloudGraphGetRingsScale(CloudGraph *cloud, CloudGraphOpt *opt, 
+  float extent);
+
+// Return the curvature of the links in the arrangement of 'opt'
+double CloudGraphGetArrangeCurvature(CloudGraphOpt *opt);
+
+// Return the index of the family 'family' in the arrays indexed by 
+// family of 'cloud' (_familyIndexSize + 2 entries): 0 for negative 
+// IDs, _familyIndexSize + 1 for IDs beyond the index, else 'family' + 1
+int CloudGraphFamilyKey(CloudGraph *cloud, int family);
+
+// Build the quadtree of the nodes of 'cloud' in the free layout 
+// 'layout'
+// Return false if memory allocation failed, else return true
+bool CloudGraphBuildQuadtree(CloudGraph *cloud, 
+  CloudGraphFreeLayout *layout);
+
+// Thread function calculating the forces on the nodes of a range in
+// the free layout
+void* CloudGraphFreeForcesTask(void *task);
+
 // Update all the bounding boxes
 // Do nothing if arguments are invalid
 void CloudGraphUpdateBoundingBox(CloudGraph *cloud, 
   CloudGraphOpt *opt);
 
+// Set the bounding box of the cloud from the bounding boxes of its 
+// nodes, links and families, without updating them
+// The bounds of the nodes and links are calculated using up to 
+// 'opt->_nbThread' threads, each on its own range, and then merged
+void CloudGraphUnionBoundingBox(CloudGraph *cloud, CloudGraphOpt *opt);
+
+// Get the bounds of the link at position 'iLink' in the columns of 
+// 'cloud' into 'min' and 'max' (2 floats each), from its bounding box
+// or, for a lazy link, from the extrema of its curve
+// Return false if the link has no bounds (lazy link toward an unknown
+// node), else return true
+bool CloudGraphGetLinkBounds(CloudGraph *cloud, int iLink, float *min, 
+  float *max);
+
+// Get the bounds of the cubic Bezier curve of control points 'ctrl' 
+// (4 points, x and y interleaved) into 'min' and 'max' (2 floats 
+// each), from the extrema of the curve
+void CloudGraphGetCurveBounds(const float *ctrl, float *min, 
+  float *max);
+
+// Update in place the bounding box of the link at position 'iLink' in
+// the columns of 'cloud' from the extrema of its curve
+// Do nothing for a lazy link, which has no bounding box
+void CloudGraphUpdateLinkBox(CloudGraph *cloud, int iLink);
+
+// Create a font for the labels of a CloudGraph
+// Return NULL if we couldn't create the font
+TGAFont* CloudGraphCreateFont(void);
+
+// Prepare the rendering 'render' of the part 'view' of 'cloud' with 
+// 'opt' into 'tga': the colors of the pencil and the elements drawn 
+// on each tile
+// Return false if memory allocation failed, else return true
+bool CloudGraphRenderInit(CloudGraphRender *render, 
+  const CloudGraph *cloud, const CloudGraphOpt *opt, TGA *tga, 
+  const CloudGraphView *view);
+
+// Free the memory used by the rendering 'render'
+void CloudGraphRenderFree(CloudGraphRender *render);
+
+// Get into 'pix' the position in the TGA of the point ('x', 'y') of 
+// the CloudGraph seen through 'view'
+void CloudGraphViewPoint(const CloudGraphView *view, float x, float y,
+  float *pix);
+
+// Add the element 'iElem' of the rendering 'render' to the tiles it 
+// is drawn on, counting them if 'fill' is false, else filling them
+void CloudGraphBinElem(CloudGraphRender *render, int iElem, bool fill);
+
+// Add the element 'iElem' of the rendering 'render' to the tiles 
+// overlapping the rectangle 'min', 'max' in the TGA
+void CloudGraphBinRect(CloudGraphRender *render, int iElem, 
+  const float *min, const float *max, bool fill);
+
+// Add the element 'iElem' of the rendering 'render' to the tiles 
+// crossed by the curve of control points 'ctrl' in the TGA, drawn 
+// 'margin' pixels thick, splitting the curve up to 'depth' times
+void CloudGraphBinCurve(CloudGraphRender *render, int iElem, 
+  const float *ctrl, float margin, int depth, bool fill);
+
+// Get the control points of the link 'iLink' of the rendering 
+// 'render', in the TGA, into 'ctrl' (4 points, x and y interleaved)
+// Return false if the link is not drawn, else return true
+bool CloudGraphGetRenderCurve(const CloudGraphRender *render, int iLink, 
+  float *ctrl);
+
+// Get the position 'origin' and dimensions 'size' in the TGA of the 
+// tile 'iTile' of the rendering 'render'
+void CloudGraphGetTile(const CloudGraphRender *render, int iTile, 
+  int *origin, int *size);
+
+// Thread function rendering the tiles of a task
+void* CloudGraphRenderTask(void *task);
+
+// Thread function getting the greatest number of links crossing a 
+// pixel of the tiles of a task in density mode
+void* CloudGraphDensityTask(void *task);
+
+// Set 'count' to the number of links of the rendering 'render' 
+// crossing each pixel of the tile 'iTile', and 'sum' (may be NULL) to 
+// the sum of their colors
+void CloudGraphAccumulateLinks(const CloudGraphRender *render, 
+  int iTile, unsigned int *count, unsigned int *sum);
+
+// Add 'weight' to 'count' and 'weight' times the color to 'sum' (may 
+// be NULL) on the pixels crossed by the piece 't[0]' to 't[1]' of a
+// link, of control points 'ctrl' in the TGA, in the tile at 'origin' 
+// of dimensions 'size', splitting it up to 'depth' times
+// '*last' is the index of the last pixel of the tile written for this
+// link, it is counted only once, or -1 before its first piece and 
+// when the link is outside the tile
+void CloudGraphAccumulateCurve(const float *ctrl, const int *origin,
+  const int *size, unsigned int weight, const unsigned char *rgba, 
+  const float *t, int depth, int *last, unsigned int *count, 
+  unsigned int *sum);
+
+// Blend the links accumulated in the tile of 'worker' with the tile,
+// tone mapped with the mode of 'render'
+void CloudGraphCompositeDensity(const CloudGraphRender *render, 
+  CloudGraphRenderWorker *worker);
+
+// Draw the element 'iElem' of the rendering 'render' on the tile of 
+// 'worker'
+// Return false if memory allocation failed, else return true
+bool CloudGraphDrawElem(CloudGraphRender *render, 
+  CloudGraphRenderWorker *worker, int iElem);
+
+// Prepare the empty atlas of glyphs 'atlas' with 'nbRotation' 
+// rotations, for a font of size 'size' and a pencil of thickness 
+// 'thickness'
+// Return false if memory allocation failed, else return true
+bool CloudGraphGlyphAtlasInit(CloudGraphGlyphAtlas *atlas, 
+  int nbRotation, float size, float thickness);
+
+// Free the memory used by the atlas of glyphs 'atlas'
+void CloudGraphGlyphAtlasFree(CloudGraphGlyphAtlas *atlas);
+
+// Get the advance of the character 'c' along the right direction of a
+// label printed with the font of 'atlas'
+float CloudGraphGetGlyphAdvance(CloudGraphGlyphAtlas *atlas, 
+  unsigned char c);
+
+// Get the glyph of the character 'c' at the rotation 'iRotation' of 
+// 'atlas', rasterizing it if it's its first use
+// Return NULL if memory allocation failed
+const CloudGraphGlyph* CloudGraphGetGlyph(CloudGraphGlyphAtlas *atlas,
+  unsigned char c, int iRotation);
+
+// Print the string 'label' in the tile of 'worker' at 'pos' in the 
+// tile, in the direction 'right' and the color 'rgba', copying the
+// glyphs of the atlas of 'worker'
+// Return false if memory allocation failed, else return true
+bool CloudGraphPrintLabel(CloudGraphRenderWorker *worker, 
+  const char *label, const float *pos, const float *right, 
+  const unsigned char *rgba);
+
+// Set the coverage mask 'mask' from 'tga', of dimensions 2 * 'half' 
+// and drawn in black on white
+// Return false if memory allocation failed, else return true
+bool CloudGraphSetMask(CloudGraphGlyph *mask, TGA *tga, int half);
+
+// Blend the color 'rgba' with the pixels of the tile of 'worker' 
+// proportionally to the coverage 'mask', whose first pixel is at 'at'
+// in the tile
+void CloudGraphBlendMask(CloudGraphRenderWorker *worker, 
+  const CloudGraphGlyph *mask, const int *at, 
+  const unsigned char *rgba);
+
+// Rasterize the disc of the nodes of the rendering 'render' centered
+// at each of the CLOUDGRAPH_SPRITEPHASE x CLOUDGRAPH_SPRITEPHASE 
+// subpixel positions
+// Return false if memory allocation failed, else return true
+bool CloudGraphRenderSprites(CloudGraphRender *render);
+
+// Set the control points of the links in the columns of 'cloud' from
+// the position and right direction of their nodes, using up to 
+// 'nbThread' threads
+// The intermediate control points are moved backward along the right 
+// direction of their node by the distance between the two nodes times
+// 'curvature'
+void CloudGraphArrangeLinks(CloudGraph *cloud, double curvature, 
+  int nbThread);
+
+// Split the nodes and links of 'cloud' into ranges for up to 
+// 'nbThread' threads, the ranges are set into 'tasks' 
+// (CLOUDGRAPH_MAXTHREAD tasks) with the options 'opt'
+// Return the number of ranges
+int CloudGraphSplitRanges(CloudGraph *cloud, CloudGraphOpt *opt, 
+  int nbThread, CloudGraphRangeTask *tasks);
+
+// Run 'fun' on the 'nbTask' tasks 'tasks', one thread per task, the 
+// first task and the tasks whose thread can't be started are run in 
+// the calling thread
+void CloudGraphRunTasks(void* (*fun)(void*), CloudGraphRangeTask *tasks,
+  int nbTask);
+
+// Thread function setting the control points of the links of a range
+void* CloudGraphArrangeLinksTask(void *task);
+
+// Thread function copying the geometry of the links of a range from 
+// the columns to the links
+void* CloudGraphPushLinksTask(void *task);
+
+// Thread function updating the bounding boxes of the links of a range
+void* CloudGraphLinkBoxesTask(void *task);
+
+// Thread function calculating the bounds of the nodes and links of a
+// range
+void* CloudGraphBoundsTask(void *task);
+
+// Extend the bounds 'min' and 'max' (2 floats each) to the box 'box'
+void CloudGraphExtendBounds(const CloudGraphBox *box, float *min, 
+  float *max);
+
+// Set the intermediate control points of the link at position 'iLink'
+// in the columns 'cols' as CloudGraphArrangeLinks with 'curvature'
+void CloudGraphArrangeLink(CloudGraphColumns *cols, int iLink, 
+  double curvature);
+
+// Kernel without vector instructions
+void CloudGraphArrangeLinksScalar(CloudGraphColumns *cols, int first, 
+  int last, float curvature);
+
+#ifdef CLOUDGRAPH_SIMDX86
+// Kernel with SSE instructions, 4 links at a time
+void CloudGraphArrangeLinksSSE(CloudGraphColumns *cols, int first, 
+  int last, float curvature);
+
+// Kernel with AVX2 instructions, 8 links at a time
+void CloudGraphArrangeLinksAVX2(CloudGraphColumns *cols, int first, 
+  int last, float curvature) __attribute__((target("avx2")));
+#endif
+
+// Return the fastest kernel setting the control points of links 
+// supported by the processor
+CloudGraphArrangeLinksKernel CloudGraphGetArrangeLinksKernel(void);
+
+// Rebuild the columns of 'cloud' from its sets of nodes and links, 
+// nodes are in the order of the set of nodes
+// The geometry in the columns is not set, see CloudGraphPullColumns
+// Return false if memory allocation failed, else return true
+bool CloudGraphUpdateColumns(CloudGraph *cloud);
+
+// Ensure the columns 'cols' can hold 'nbNode' nodes, 'nbLink' links 
+// and node IDs up to 'nbId' - 1
+// Return false if memory allocation failed, else return true
+bool CloudGraphColumnsReserve(CloudGraphColumns *cols, int nbNode, 
+  int nbLink, int nbId);
+
+// Reallocate '*ptr' to 'size' bytes
+// Return false if memory allocation failed, '*ptr' is then unchanged,
+// else return true
+bool CloudGraphRealloc(void **ptr, size_t size);
+
+// Free the memory used by the columns 'cols'
+void CloudGraphColumnsFree(CloudGraphColumns *cols);
+
+// Copy the geometry in the columns of 'cloud' to its nodes and links,
+// which gives the result of an arrangement to the callers
+// The links are copied using up to 'nbThread' threads
+void CloudGraphPushColumns(CloudGraph *cloud, int nbThread);
+
+// Copy the geometry of the link at position 'iLink' in the columns of
+// 'cloud' to the link
+void CloudGraphPushLink(CloudGraph *cloud, int iLink);
+
+// Copy the geometry of the nodes and links of 'cloud' to its columns,
+// after they are rebuilt or a layout is loaded from the cache
+void CloudGraphPullColumns(CloudGraph *cloud);
+
+// Ensure the columns of 'cloud' reflect its nodes and links, rebuild 
+// them from the nodes and links if they have been modified
+// Return false if memory allocation failed, else return true
+bool CloudGraphEnsureColumns(CloudGraph *cloud);
+
+// Rebuild the adjacency of 'cloud' from its links
+// Return false if memory allocation failed, else return true
+bool CloudGraphUpdateAdjacency(CloudGraph *cloud);
+
+// Ensure the adjacency of 'cloud' reflects its nodes and links, 
+// rebuild it if it couldn't be kept up to date
+// Return false if memory allocation failed, else return true
+bool CloudGraphEnsureAdjacency(CloudGraph *cloud);
+
+// Ensure the adjacency 'adj' has room for 'nb' rows
+// Return false if memory allocation failed, else return true
+bool CloudGraphAdjacencyReserveRows(CloudGraphAdjacency *adj, int nb);
+
+// Ensure the adjacency 'adj' has room for 'nb' more neighbors after 
+// its last row
+// Return false if memory allocation failed, else return true
+bool CloudGraphAdjacencyReserveNeighbors(CloudGraphAdjacency *adj, 
+  int nb);
+
+// Add the link 'link', just added to 'cloud', to the rows of its nodes
+// in the adjacency of 'cloud' if it is up to date
+void CloudGraphAdjacencyAddLink(CloudGraph *cloud, CloudGraphLink *link);
+
+// Add the row of the node 'id', just added to 'cloud', to the 
+// adjacency of 'cloud' if it is up to date
+void CloudGraphAdjacencyAddNode(CloudGraph *cloud, int id);
+
+// Free the memory used by the adjacency 'adj'
+void CloudGraphAdjacencyFree(CloudGraphAdjacency *adj);
+
+// If 'cloud' bundles its links and has a link between the nodes 
+// 'from' and 'to', in any direction, add 'weight' to the weight of 
+// this link, the weight saturates at INT_MAX
+// Return true if 'weight' was added to a link, else return false
+bool CloudGraphAddToBundle(CloudGraph *cloud, int from, int to, 
+  int weight);
+
+// Return the position of the slot of the set of links 'set' holding 
+// the link between the nodes 'from' and 'to', in any direction, or of
+// the empty slot where it would be inserted
+// The capacity of 'set' must not be 0
+int CloudGraphLinkSetSlot(const CloudGraphLinkSet *set, int from, 
+  int to);
+
+// Ensure the set of links 'set' can hold 'nb' links
+// Return false if memory allocation failed, else return true
+bool CloudGraphLinkSetReserve(CloudGraphLinkSet *set, int nb);
+
+// Insert the link 'link' in the set of links 'set', which must have 
+// been reserved for it and not contain a link between the same nodes
+void CloudGraphLinkSetInsert(CloudGraphLinkSet *set, 
+  CloudGraphLink *link);
+
+// Free the memory used by the set of links 'set'
+void CloudGraphLinkSetFree(CloudGraphLinkSet *set);
+
+// Return the position of the first slot probed in the set of links 
+// 'set' for the link between the nodes 'from' and 'to'
+int CloudGraphLinkSetHome(const CloudGraphLinkSet *set, int from, 
+  int to);
+
+// Remove the link 'link' from the set of links 'set'
+// Do nothing if 'link' is not in 'set'
+void CloudGraphLinkSetRemove(CloudGraphLinkSet *set, 
+  CloudGraphLink *link);
+
+// Get in 'width' and 'height' the size of the bounding box of 'label'
+// (an empty label if NULL) with the font of 'cloud' at 'size', before
+// rotation, from the cache of label metrics of 'cloud', measuring it 
+// if it is not in the cache yet
+// Return false if memory allocation failed, else return true
+bool CloudGraphGetLabelMetric(CloudGraph *cloud, const char *label, 
+  float size, float *width, float *height);
+
+// Get in 'width' and 'height' the size of the bounding box of the 
+// label of 'node' at 'size' as CloudGraphGetLabelMetric, from the size
+// memorized in 'node' if it was measured at 'size', else memorize it
+// Return false if memory allocation failed, else return true
+bool CloudGraphGetNodeLabelMetric(CloudGraph *cloud, 
+  CloudGraphNode *node, float size, float *width, float *height);
+
+// Return the position of the slot of the cache of label metrics 
+// 'cache' holding the metrics of 'label' at 'size', whose hash is 
+// 'hash', or of the empty slot where they would be inserted
+// The capacity of 'cache' must not be 0
+int CloudGraphLabelCacheSlot(const CloudGraphLabelCache *cache, 
+  const char *label, float size, uint64_t hash);
+
+// Ensure the cache of label metrics 'cache' can hold 'nb' metrics
+// Return false if memory allocation failed, else return true
+bool CloudGraphLabelCacheReserve(CloudGraphLabelCache *cache, int nb);
+
+// Free the memory used by the cache of label metrics 'cache'
+void CloudGraphLabelCacheFree(CloudGraphLabelCache *cache);
+
+// Set the bounding box of a label 'bound' to 'width' and 'height' 
+// rotated to the right direction 'right' (2 floats)
+// Its position is left unchanged
+void CloudGraphSetLabelBound(CloudGraphBox *bound, float width, 
+  float height, const float *right);
+
+// Add the link 'link', just added to the set of links of 'cloud', to
+// the columns and the dirty links of 'cloud' if its changes are 
+// tracked
+// Return false if the changes are not tracked or memory allocation 
+// failed, in which case the columns must be rebuilt, else return true
+bool CloudGraphTrackLink(CloudGraph *cloud, CloudGraphLink *link);
+
+// Return a link of 'cloud' between the nodes 'from' and 'to', in any
+// direction, or NULL if there is no such link
+CloudGraphLink* CloudGraphFindLink(CloudGraph *cloud, int from, int to);
+
+// Remove the link 'link' from the rows of its nodes in the adjacency 
+// of 'cloud' if it is up to date
+void CloudGraphAdjacencyRemoveLink(CloudGraph *cloud, 
+  CloudGraphLink *link);
+
+// Remove the link 'link' from 'cloud' and release it, 'iCol' is its 
+// position in the columns or -1 if unknown, in which case the 
+// columns will be rebuilt
+void CloudGraphDeleteLink(CloudGraph *cloud, CloudGraphLink *link, 
+  int iCol);
+
+// Remove the link at position 'iLink' from the columns of 'cloud' by
+// moving the last link in its place
+void CloudGraphColumnsRemoveLink(CloudGraph *cloud, int iLink);
+
+// Forget the changes of 'cloud' since the last arrangement, its 
+// columns reflect its new arrangement
+// The dirty flag of the links is cleared if 'allLinks' is true, else
+// the caller must have cleared it for the dirty links
+void CloudGraphResetDirty(CloudGraph *cloud, bool allLinks);
+
+// Add a link between the nodes 'from' and 'to' to the CloudGraph 
+// 'cloud', the link is created in the arena only if it can't be 
+// bundled into a link already in 'cloud'
+// Return the same codes as CloudGraphLoad
+int CloudGraphAddLinkNodes(CloudGraph *cloud, int from, int to);
+
+// Ensure the index of nodes can hold the ID 'id'
+// Return false if arguments are invalid, if 'id' can't be indexed 
+// (INT_MAX) or memory allocation failed, else return true
+bool CloudGraphReserveNodeIndex(CloudGraph *cloud, int id);
+
+// Return the hash of the content of the CloudGraph 'cloud' (families,
+// nodes in their current order, links, lazy links flag) and the 
+// options of 'opt' affecting the layout, used as the key of the layout
+// cache
+uint64_t CloudGraphLayoutHash(CloudGraph *cloud, CloudGraphOpt *opt);
+
+// Update the FNV-1a hash 'hash' with the 'size' bytes at 'data'
+// Return the updated hash
+uint64_t CloudGraphHashBytes(uint64_t hash, const void *data, 
+  size_t size);
+
+// Get in 'path' (of size 'size') the path of the file of the layout 
+// cache for the key 'hash' in the directory of 'opt'
+void CloudGraphLayoutCachePath(CloudGraphOpt *opt, uint64_t hash, 
+  char *path, size_t size);
+
+// Return the number of floats in a layout cache file for 'cloud'
+size_t CloudGraphLayoutCacheSize(CloudGraph *cloud);
+
+// Copy the position and axis of the 2D Shapoid 's' into 'v' (6 floats)
+// 'v' is set to 0.0 if 's' is NULL
+void CloudGraphShapoidToFloat(Shapoid *s, float *v);
+
+// Set the position and axis of the 2D Shapoid '*s' from 'v' (6 
+// floats), the Shapoid is created as a Facoid if '*s' is NULL
+// Return false if the Shapoid couldn't be created, else return true
+bool CloudGraphFloatToShapoid(const float *v, Shapoid **s);
+
+// Copy the position and axis of the box 'box' into 'v' (6 floats), 
+// in the same order as CloudGraphShapoidToFloat
+void CloudGraphBoxToFloat(const CloudGraphBox *box, float *v);
+
+// Set the position and axis of the box 'box' from 'v' (6 floats)
+void CloudGraphFloatToBox(const float *v, CloudGraphBox *box);
+
+// Load the layout of the CloudGraph 'cloud' for the key 'hash' from 
+// the layout cache of 'opt'
+// The nodes must already be sorted by family
+// Return true if the layout was found and applied, false else
+bool CloudGraphLoadLayout(CloudGraph *cloud, CloudGraphOpt *opt, 
+  uint64_t hash);
+
+// Save the layout of the CloudGraph 'cloud' for the key 'hash' into 
+// the layout cache of 'opt'
+// Return true if the layout could be saved, false else
+bool CloudGraphSaveLayout(CloudGraph *cloud, CloudGraphOpt *opt, 
+  uint64_t hash);
+
+// Ensure the index of families can hold the ID 'id'
+// Return false if arguments are invalid, if 'id' can't be indexed 
+// (INT_MAX) or memory allocation failed, else return true
+bool CloudGraphReserveFamilyIndex(CloudGraph *cloud, int id);
+
+// Add the family 'family' itself to the CloudGraph, the CloudGraph 
+// takes ownership of it
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of 'family', else return true
+bool CloudGraphAppendFamily(CloudGraph *cloud, CloudGraphFamily *family);
+
+// Add the node 'node' itself to the CloudGraph, the CloudGraph takes 
+// ownership of it
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of 'node', else return true
+bool CloudGraphAppendNode(CloudGraph *cloud, CloudGraphNode *node);
+
+// Add the link 'link' itself to the CloudGraph, the CloudGraph takes 
+// ownership of it
+// If the CloudGraph bundles its links and already has a link between
+// the same nodes, the weight of 'link' is added to this link and 
+// 'link' is released
+// Return false if the arguments are invalid or memory allocation 
+// failed, in which case the caller keeps the ownership of 'link', 
+// else return true
+bool CloudGraphAppendLink(CloudGraph *cloud, CloudGraphLink *link);
+
+// Copy the data of the family, node or link 'src' into 'dst' created
+// in the arena of 'cloud', labels are copied in the arena
+// Return false if memory allocation failed, else return true
+bool CloudGraphCopyFamily(CloudGraph *cloud, CloudGraphFamily *dst, 
+  CloudGraphFamily *src);
+bool CloudGraphCopyNode(CloudGraph *cloud, CloudGraphNode *dst, 
+  CloudGraphNode *src);
+void CloudGraphCopyLink(CloudGraphLink *dst, CloudGraphLink *src);
+
+// Return true if 'label' points into the memory mapping of 'cloud',
+// in which case it must not be freed
+bool CloudGraphIsMappedLabel(CloudGraph *cloud, char *label);
+
+// Allocate 'size' bytes in the arena of 'cloud', the memory is 
+// released all at once by CloudGraphFree
+// Return NULL if arguments are invalid or memory allocation failed
+void* CloudGraphArenaAlloc(CloudGraph *cloud, size_t size);
+
+// Copy the string 'str' in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+char* CloudGraphArenaCopyString(CloudGraph *cloud, const char *str);
+
+// Return true if 'ptr' points into the arena of 'cloud', in which case
+// it must not be freed
+bool CloudGraphArenaOwns(CloudGraph *cloud, const void *ptr);
+
+// Free the blocks of the arena of 'cloud'
+void CloudGraphArenaFree(CloudGraph *cloud);
+
+// Create a CloudGraphFamily, CloudGraphNode or CloudGraphLink with 
+// default values (see CloudGraphCreateFamily, CloudGraphCreateNode 
+// and CloudGraphCreateLink) in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphFamily* CloudGraphArenaCreateFamily(CloudGraph *cloud);
+CloudGraphNode* CloudGraphArenaCreateNode(CloudGraph *cloud);
+CloudGraphLink* CloudGraphArenaCreateLink(CloudGraph *cloud);
+
+// Create 'nb' contiguous CloudGraphFamily, CloudGraphNode or 
+// CloudGraphLink with default values in the arena of 'cloud' with a
+// single allocation
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphFamily* CloudGraphArenaCreateFamilies(CloudGraph *cloud, 
+  int nb);
+CloudGraphNode* CloudGraphArenaCreateNodes(CloudGraph *cloud, int nb);
+CloudGraphLink* CloudGraphArenaCreateLinks(CloudGraph *cloud, int nb);
+
+// Set the default values of the family, node or link, the link is 
+// lazy if 'lazy' is true
+void CloudGraphFamilyInit(CloudGraphFamily *family);
+void CloudGraphNodeInit(CloudGraphNode *node);
+void CloudGraphLinkInit(CloudGraphLink *link, bool lazy);
+
+// Free the memory used by the family, node or link of the CloudGraph
+// 'cloud', the memory in the arena or the memory mapping of 'cloud' 
+// is left to CloudGraphFree
+// Do nothing if arguments are invalid
+void CloudGraphReleaseFamily(CloudGraph *cloud, CloudGraphFamily **family);
+void CloudGraphReleaseNode(CloudGraph *cloud, CloudGraphNode **node);
+void CloudGraphReleaseLink(CloudGraph *cloud, CloudGraphLink **link);
+
+// Load the CloudGraph 'cloud' from the data between 'ptr' and 'end'
+// in the text format of CloudGraphLoad
+// Labels are not copied: the line return after each label is replaced
+// with '\0' and the label points into the data
+// The links are parsed with 'nbThread' threads
+// Return the same codes as CloudGraphLoad
+int CloudGraphLoadMapped(CloudGraph *cloud, char *ptr, char *end, 
+  int nbThread);
+
+// Load the 'nbLink' links of the CloudGraph 'cloud' from the data 
+// between 'ptr' and 'end' using 'nbThread' threads
+// Links are expected to be one per line, node IDs must be in 
+// [0, 'nbNode'[
+// Return the same codes as CloudGraphLoad
+int CloudGraphLoadLinksParallel(CloudGraph *cloud, char *ptr, char *end,
+  int nbNode, int nbLink, int nbThread);
+
+// Parse the pairs of node IDs of links in the chunk 'arg' (a 
+// CloudGraphLinkChunk) until the end of the chunk or invalid data
+// Thread function of CloudGraphLoadLinksParallel
+// Return NULL
+void* CloudGraphParseLinkChunk(void *arg);
+
+// Skip the white spaces and read an integer in the data between '*ptr' 
+// and 'end' into 'val', and move '*ptr' after the integer
+// Return false if there is no integer at '*ptr', else return true
+bool CloudGraphScanInt(char **ptr, char *end, int *val);
+
+// Skip the white spaces and get the label up to the end of the line in
+// the data between '*ptr' and 'end' of the memory mapping of 'cloud' 
+// into 'label', and move '*ptr' to the next line
+// Return false if the label is empty ('*label' is NULL) or memory 
+// allocation failed ('*label' is not NULL), else return true
+bool CloudGraphScanLabel(CloudGraph *cloud, char **ptr, char *end, 
+  char **label);
+
+// Write the unsigned integer 'v' at 'buf' in little-endian order
+void CloudGraphPutU32(unsigned char *buf, uint32_t v);
+
+// Return the unsigned integer written at 'buf' in little-endian order
+uint32_t CloudGraphGetU32(const unsigned char *buf);
+
+// Mark the views of 'cloud' obtained with CloudGraphGetView before a 
+// change of its nodes, families, links or arrangement as out of date,
+// CloudGraphToTGAView refuses to render them
+void CloudGraphInvalidateViews(CloudGraph *cloud);
+
 // ================ Functions implementation ====================
 
 // Create a new CloudGraph
@@ -43,23 +1014,35 @@ CloudGraph* CloudGraphCreate(void) {
     ret->_nodes = GSetCreate();
     ret->_families = GSetCreate();
     ret->_links = GSetCreate();
-    ret->_font = TGAFontCreate(tgaFontDefault);
+    ret->_font = CloudGraphCreateFont();
     ret->_boundingBox = FacoidCreate(2);
+    ret->_nodeIndex = NULL;
+    ret->_nodeIndexSize = 0;
+    ret->_nodeIndexCapacity = 0;
+    ret->_familyIndex = NULL;
+    ret->_familyIndexSize = 0;
+    ret->_familyIndexCapacity = 0;
+    ret->_map = NULL;
+    ret->_mapSize = 0;
+    memset(&(ret->_cols), 0, sizeof(CloudGraphColumns));
+    memset(&(ret->_adj), 0, sizeof(CloudGraphAdjacency));
+    ret->_generation = 0;
+    ret->_arena = NULL;
+    ret->_arenaBlocks = NULL;
+    ret->_nbArenaBlock = 0;
+    ret->_capacityArenaBlock = 0;
+    ret->_nbOwned = 0;
+    ret->_lazyLinks = false;
+    ret->_bundleLinks = false;
+    memset(&(ret->_linkSet), 0, sizeof(CloudGraphLinkSet));
+    memset(&(ret->_dirty), 0, sizeof(CloudGraphDirty));
+    memset(&(ret->_labelCache), 0, sizeof(CloudGraphLabelCache));
     // If we couldn't allocate memory
     if (ret->_nodes == NULL || ret->_families == NULL || 
       ret->_font == NULL || ret->_boundingBox == NULL) {
       // Free memory
       CloudGraphFree(&ret);
     }
-    // Set the font anchor 
-    TGAFontSetAnchor(ret->_font, tgaFontAnchorCenterLeft);
-    // Set the font scale
-    VecFloat *v = VecFloatCreate(2);
-    if (v != NULL) {
-      VecSet(v, 0, 0.5); VecSet(v, 1, 1.0);
-      TGAFontSetScale(ret->_font, v); 
-      VecFree(&v);
-    }
   }
   // Return the new CloudGraph
   return ret;
@@ -71,23 +1054,31 @@ void CloudGraphFree(CloudGraph **cloud) {
   // Check arguments
   if (cloud == NULL || *cloud == NULL)
     return;
-  // Free memory used by nodes
-  GSetElem *elem = (*cloud)->_nodes->_head;
-  while (elem != NULL) {
-    CloudGraphNodeFree((CloudGraphNode**)(&(elem->_data)));
-    elem = elem->_next;
-  }
-  // Free memory used by families
-  elem = (*cloud)->_families->_head;
-  while (elem != NULL) {
-    CloudGraphFamilyFree((CloudGraphFamily**)(&(elem->_data)));
-    elem = elem->_next;
-  }
-  // Free memory used by links
-  elem = (*cloud)->_links->_head;
-  while (elem != NULL) {
-    CloudGraphLinkFree((CloudGraphLink**)(&(elem->_data)));
-    elem = elem->_next;
+  // If some nodes, families or links have been allocated outside of 
+  // the arena, free them, the others don't refer to any other memory 
+  // and are released at once with the arena
+  if ((*cloud)->_nbOwned > 0) {
+    // Free memory used by nodes
+    GSetElem *elem = (*cloud)->_nodes->_head;
+    while (elem != NULL) {
+      CloudGraphReleaseNode(*cloud, 
+        (CloudGraphNode**)(&(elem->_data)));
+      elem = elem->_next;
+    }
+    // Free memory used by families
+    elem = (*cloud)->_families->_head;
+    while (elem != NULL) {
+      CloudGraphReleaseFamily(*cloud, 
+        (CloudGraphFamily**)(&(elem->_data)));
+      elem = elem->_next;
+    }
+    // Free memory used by links
+    elem = (*cloud)->_links->_head;
+    while (elem != NULL) {
+      CloudGraphReleaseLink(*cloud, 
+        (CloudGraphLink**)(&(elem->_data)));
+      elem = elem->_next;
+    }
   }
   // Free memory
   GSetFree(&((*cloud)->_nodes));
@@ -95,6 +1086,21 @@ void CloudGraphFree(CloudGraph **cloud) {
   GSetFree(&((*cloud)->_links));
   TGAFreeFont(&((*cloud)->_font));
   ShapoidFree(&((*cloud)->_boundingBox));
+  if ((*cloud)->_nodeIndex != NULL)
+    free((*cloud)->_nodeIndex);
+  if ((*cloud)->_familyIndex != NULL)
+    free((*cloud)->_familyIndex);
+  if ((*cloud)->_map != NULL)
+    munmap((*cloud)->_map, (*cloud)->_mapSize);
+  CloudGraphColumnsFree(&((*cloud)->_cols));
+  CloudGraphAdjacencyFree(&((*cloud)->_adj));
+  CloudGraphLinkSetFree(&((*cloud)->_linkSet));
+  CloudGraphLabelCacheFree(&((*cloud)->_labelCache));
+  if ((*cloud)->_dirty._links != NULL)
+    free((*cloud)->_dirty._links);
+  // Free the arena, releasing at once the nodes, families, links and
+  // labels allocated in it
+  CloudGraphArenaFree(*cloud);
   free(*cloud);
   *cloud = NULL;
 }
@@ -106,13 +1112,8 @@ void CloudGraphNodeFree(CloudGraphNode** node) {
   if (node == NULL || *node == NULL)
     return;
   // Free the memory used by the node
-  VecFree(&((*node)->_pos));
-  VecFree(&((*node)->_right));
   if ((*node)->_label != NULL)
     free((*node)->_label);
-  ShapoidFree(&((*node)->_boundingBox));
-  if ((*node)->_boundingBoxLbl != NULL)
-    ShapoidFree(&((*node)->_boundingBoxLbl));
   free(*node);
   *node = NULL;
 }
@@ -124,13 +1125,8 @@ void CloudGraphFamilyFree(CloudGraphFamily** family) {
   if (family == NULL || *family == NULL)
     return;
   // Free the memory used by the family
-  VecFree(&((*family)->_pos));
-  VecFree(&((*family)->_right));
   if ((*family)->_label != NULL)
     free((*family)->_label);
-  // Free the memory used by the bounding box
-  if ((*family)->_boundingBox != NULL)
-    ShapoidFree(&((*family)->_boundingBox));
   free(*family);
   *family = NULL;
 }
@@ -140,12 +1136,190 @@ void CloudGraphFamilyFree(CloudGraphFamily** family) {
 void CloudGraphLinkFree(CloudGraphLink** link) {
   if (link == NULL || *link == NULL)
     return;
-  BCurveFree(&((*link)->_curve));
-  ShapoidFree(&((*link)->_boundingBox));
   free(*link);
   *link = NULL;
 }
 
+// Free the memory used by the family 'family' of the CloudGraph 
+// 'cloud', the memory in the arena or the memory mapping of 'cloud' 
+// is left to CloudGraphFree
+// Do nothing if arguments are invalid
+void CloudGraphReleaseFamily(CloudGraph *cloud, 
+  CloudGraphFamily **family) {
+  // Check arguments
+  if (cloud == NULL || family == NULL || *family == NULL)
+    return;
+  // If the family is in the arena, it is released with the arena
+  if (CloudGraphArenaOwns(cloud, *family)) {
+    *family = NULL;
+    return;
+  }
+  // Labels in the memory mapping or the arena are released with them
+  if (CloudGraphIsMappedLabel(cloud, (*family)->_label) ||
+    CloudGraphArenaOwns(cloud, (*family)->_label))
+    (*family)->_label = NULL;
+  CloudGraphFamilyFree(family);
+}
+
+// Free the memory used by the node 'node' of the CloudGraph 'cloud', 
+// the memory in the arena or the memory mapping of 'cloud' is left to
+// CloudGraphFree
+// Do nothing if arguments are invalid
+void CloudGraphReleaseNode(CloudGraph *cloud, CloudGraphNode **node) {
+  // Check arguments
+  if (cloud == NULL || node == NULL || *node == NULL)
+    return;
+  // If the node is in the arena, it is released with the arena
+  if (CloudGraphArenaOwns(cloud, *node)) {
+    *node = NULL;
+    return;
+  }
+  // Labels in the memory mapping or the arena are released with them
+  if (CloudGraphIsMappedLabel(cloud, (*node)->_label) ||
+    CloudGraphArenaOwns(cloud, (*node)->_label))
+    (*node)->_label = NULL;
+  CloudGraphNodeFree(node);
+}
+
+// Free the memory used by the link 'link' of the CloudGraph 'cloud', 
+// the memory in the arena of 'cloud' is left to CloudGraphFree
+// Do nothing if arguments are invalid
+void CloudGraphReleaseLink(CloudGraph *cloud, CloudGraphLink **link) {
+  // Check arguments
+  if (cloud == NULL || link == NULL || *link == NULL)
+    return;
+  // If the link is in the arena, it is released with the arena
+  if (CloudGraphArenaOwns(cloud, *link)) {
+    *link = NULL;
+    return;
+  }
+  CloudGraphLinkFree(link);
+}
+
+// Allocate 'size' bytes in the arena of 'cloud', the memory is 
+// released all at once by CloudGraphFree
+// Return NULL if arguments are invalid or memory allocation failed
+void* CloudGraphArenaAlloc(CloudGraph *cloud, size_t size) {
+  // Check arguments
+  if (cloud == NULL || size == 0)
+    return NULL;
+  // Round the size up to keep the allocations aligned
+  size = (size + CLOUDGRAPH_ARENAALIGN - 1) / CLOUDGRAPH_ARENAALIGN * 
+    CLOUDGRAPH_ARENAALIGN;
+  // Declare a pointer to the current block
+  CloudGraphArenaBlock *block = cloud->_arena;
+  // If there is no room left in the current block
+  if (block == NULL || block->_size - block->_used < size) {
+    // Double the size of the blocks up to the maximum, or more if
+    // the allocation requires it
+    size_t sizeBlock = CLOUDGRAPH_ARENASIZEBLOCK;
+    if (block != NULL && block->_size < CLOUDGRAPH_ARENAMAXSIZEBLOCK)
+      sizeBlock = 2 * block->_size;
+    else if (block != NULL)
+      sizeBlock = CLOUDGRAPH_ARENAMAXSIZEBLOCK;
+    if (sizeBlock < size)
+      sizeBlock = size;
+    // Ensure there is room for the new block in the sorted blocks
+    if (cloud->_nbArenaBlock == cloud->_capacityArenaBlock) {
+      int capacity = 2 * cloud->_capacityArenaBlock + 16;
+      if (CloudGraphRealloc((void**)&(cloud->_arenaBlocks), 
+        sizeof(CloudGraphArenaBlock*) * capacity) == false)
+        return NULL;
+      cloud->_capacityArenaBlock = capacity;
+    }
+    // Allocate the new block
+    CloudGraphArenaBlock *newBlock = (CloudGraphArenaBlock*)malloc(
+      CLOUDGRAPH_ARENASIZEHEADER + sizeBlock);
+    // If we couldn't allocate memory
+    if (newBlock == NULL)
+      // Stop here
+      return NULL;
+    // Set the new block as the head of the arena
+    newBlock->_next = block;
+    newBlock->_size = sizeBlock;
+    newBlock->_used = 0;
+    cloud->_arena = newBlock;
+    block = newBlock;
+    // Insert the new block in the blocks sorted by address
+    int iBlock = cloud->_nbArenaBlock;
+    while (iBlock > 0 && 
+      (uintptr_t)(cloud->_arenaBlocks[iBlock - 1]) > (uintptr_t)block) {
+      cloud->_arenaBlocks[iBlock] = cloud->_arenaBlocks[iBlock - 1];
+      --iBlock;
+    }
+    cloud->_arenaBlocks[iBlock] = block;
+    ++(cloud->_nbArenaBlock);
+  }
+  // Allocate the memory in the current block
+  void *ret = (char*)block + CLOUDGRAPH_ARENASIZEHEADER + block->_used;
+  block->_used += size;
+  // Return the allocated memory
+  return ret;
+}
+
+// Copy the string 'str' in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+char* CloudGraphArenaCopyString(CloudGraph *cloud, const char *str) {
+  // Check arguments
+  if (cloud == NULL || str == NULL)
+    return NULL;
+  // Allocate memory in the arena
+  size_t length = strlen(str) + 1;
+  char *ret = (char*)CloudGraphArenaAlloc(cloud, sizeof(char) * length);
+  // If we could allocate memory
+  if (ret != NULL)
+    // Copy the string
+    memcpy(ret, str, sizeof(char) * length);
+  // Return the copy
+  return ret;
+}
+
+// Return true if 'ptr' points into the arena of 'cloud', in which case
+// it must not be freed
+// The block which may hold 'ptr' is found by binary search in the 
+// blocks sorted by address, in O(log(nb blocks))
+bool CloudGraphArenaOwns(CloudGraph *cloud, const void *ptr) {
+  // Check arguments
+  if (cloud == NULL || ptr == NULL)
+    return false;
+  // Search the last block starting before 'ptr'
+  int first = 0;
+  int last = cloud->_nbArenaBlock;
+  while (first < last) {
+    int mid = first + (last - first) / 2;
+    if ((uintptr_t)(cloud->_arenaBlocks[mid]) <= (uintptr_t)ptr)
+      first = mid + 1;
+    else
+      last = mid;
+  }
+  // If there is no such block, the pointer is not in the arena
+  if (first == 0)
+    return false;
+  // Check if the pointer is in the allocated data of the block
+  const CloudGraphArenaBlock *block = cloud->_arenaBlocks[first - 1];
+  uintptr_t data = (uintptr_t)block + CLOUDGRAPH_ARENASIZEHEADER;
+  return ((uintptr_t)ptr >= data && 
+    (uintptr_t)ptr < data + block->_used);
+}
+
+// Free the blocks of the arena of 'cloud'
+void CloudGraphArenaFree(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return;
+  // Free the blocks
+  while (cloud->_arena != NULL) {
+    CloudGraphArenaBlock *block = cloud->_arena;
+    cloud->_arena = block->_next;
+    free(block);
+  }
+  if (cloud->_arenaBlocks != NULL)
+    free(cloud->_arenaBlocks);
+  cloud->_arenaBlocks = NULL;
+  cloud->_nbArenaBlock = 0;
+  cloud->_capacityArenaBlock = 0;
+}
+
 // Set the represention mode to 'mode'
 // Do nothing if arguments are invalid
 void CloudGraphOptSetMode(CloudGraphOpt *opt, CloudGraphMode mode) {
@@ -169,6 +1343,9 @@ bool CloudGraphCreateRnd(CloudGraph **cloud, int nbNodeMin,
     nbFamilyMin < 1 || nbFamilyMax < nbFamilyMin || 
     density < 0.0 || density > 1.0)
     return false;
+  // Memorize the mode of the links of the cloud
+  bool lazyLinks = (*cloud != NULL && (*cloud)->_lazyLinks);
+  bool bundleLinks = (*cloud != NULL && (*cloud)->_bundleLinks);
   // If cloud is not NULL
   if (*cloud != NULL)
     // Free the cloud
@@ -179,102 +1356,63 @@ bool CloudGraphCreateRnd(CloudGraph **cloud, int nbNodeMin,
   if (*cloud == NULL)
     // Stop here
     return false;
+  (*cloud)->_lazyLinks = lazyLinks;
+  (*cloud)->_bundleLinks = bundleLinks;
   // Choose a number of nodes and families
   int nbNode = nbNodeMin + 
     (int)floor(rnd() * (float)(nbNodeMax - nbNodeMin));
   int nbFamily = nbFamilyMin + 
     (int)floor(rnd() * (float)(nbFamilyMax - nbFamilyMin));
-  // Declare a variable to create the families
-  CloudGraphFamily *family = CloudGraphCreateFamily();
-  // If we couldn't allocate memory
-  if (family == NULL) {
-    // Free memory
-    CloudGraphFree(cloud);
-    // Stop here
-    return false;
-  }
-  // Allocate memory for the label
-  family->_label = (char*)malloc(sizeof(char) * 100);
-  // If we couldn't allocate memory
-  if (family->_label == NULL) {
-    // Stop here
-    CloudGraphFamilyFree(&family);
-    CloudGraphFree(cloud);
-    return false;
-  }
-  // Create the families
+  // Create the families in the arena and add them themselves to the 
+  // cloud, instead of copying a scratch family
   for (int iFamily = 0; iFamily < nbFamily; ++iFamily) {
-    // Set the properties
-    family->_id = iFamily;
-    sprintf(family->_label, "Family%03d", iFamily);
-    for (int iRGB = 0; iRGB < 3; ++iRGB)
-      family->_rgba[iRGB] = (char)floor(rnd() * 255.0);
-    // Add the family
-    bool ret = CloudGraphAddFamily(*cloud, family);
-    // If we couldn't add the family
-    if (ret == false) {
+    char label[100] = {'\0'};
+    sprintf(label, "Family%03d", iFamily);
+    CloudGraphFamily *family = CloudGraphArenaCreateFamily(*cloud);
+    if (family != NULL) {
+      // Set the properties
+      family->_id = iFamily;
+      for (int iRGB = 0; iRGB < 3; ++iRGB)
+        family->_rgba[iRGB] = (char)floor(rnd() * 255.0);
+      family->_label = CloudGraphArenaCopyString(*cloud, label);
+    }
+    // If we couldn't create or add the family
+    if (family == NULL || family->_label == NULL ||
+      CloudGraphAppendFamily(*cloud, family) == false) {
       // Stop here
-      CloudGraphFamilyFree(&family);
+      CloudGraphReleaseFamily(*cloud, &family);
       CloudGraphFree(cloud);
       return false;
     }
   }
-  // Free memory
-  CloudGraphFamilyFree(&family);
-  // Declare a variable to create the nodes
-  CloudGraphNode *n = CloudGraphCreateNode();
-  // If we couldn't allocate memory
-  if (n == NULL) {
-    // Stop here
-    CloudGraphFree(cloud);
-    return false;
-  }
   // Create the nodes
   for (int iNode = 0; iNode < nbNode; ++iNode) {
-    // Set the data of the node
-    n->_id = iNode;
-    n->_family = (int)floor(rnd() * (float)(nbFamily));
     char label[100] = {'\0'};
     sprintf(label, "Node%03d", iNode);
-    n->_label = (char*)malloc(sizeof(char) * (strlen(label) + 1));
-    // If we couldn't allocate memory for the label
-    if (n->_label == NULL) {
+    CloudGraphNode *n = CloudGraphArenaCreateNode(*cloud);
+    if (n != NULL) {
+      // Set the data of the node
+      n->_id = iNode;
+      n->_family = (int)floor(rnd() * (float)(nbFamily));
+      n->_label = CloudGraphArenaCopyString(*cloud, label);
+    }
+    // If we couldn't create or add the node
+    if (n == NULL || n->_label == NULL ||
+      CloudGraphAppendNode(*cloud, n) == false) {
       // Stop here
-      CloudGraphNodeFree(&n);
+      CloudGraphReleaseNode(*cloud, &n);
       CloudGraphFree(cloud);
       return false;
     }
-    memcpy(n->_label, label, sizeof(char) * (strlen(label) + 1));
-    // Add the node
-    CloudGraphAddNode(*cloud, n);
-    // Free memory used for the label
-    free(n->_label);
-    n->_label = NULL;
-  }
-  // Free memory
-  CloudGraphNodeFree(&n);
-  // Declare a variable to create the links
-  CloudGraphLink *l = CloudGraphCreateLink();
-  // If we couldn't allocate memory
-  if (l == NULL) {
-    // Stop here
-    CloudGraphFree(cloud);
-    return false;
   }
   // For each pair of nodes
   for (int iNode = 0; iNode < nbNode - 1; ++iNode) {
     for (int jNode = iNode + 1; jNode < nbNode; ++jNode) {
       // If the link between this pair exist
       if (rnd() <= density) {
-        // Set the data
-        l->_nodes[0] = iNode;
-        l->_nodes[1] = jNode;
-        // Add the link
-        bool ret = CloudGraphAddLink(*cloud, l);
-        // If we couldn't add the link
-        if (ret == false) {
+        // If we couldn't create or add the link
+        if (CloudGraphAddLinkNodes(*cloud, iNode, jNode) != 0) {
           // Free memory
-          CloudGraphLinkFree(&l);
           CloudGraphFree(cloud);
           // Stop here
           return false;
@@ -282,8 +1420,6 @@ bool CloudGraphCreateRnd(CloudGraph **cloud, int nbNodeMin,
       }
     }
   }
-  // Free memory
-  CloudGraphLinkFree(&l);
   // Return the success code
   return true;
 }
@@ -297,84 +1433,252 @@ CloudGraphFamily* CloudGraphCreateFamily(void) {
   // Allocate memory
   CloudGraphFamily *ret = 
     (CloudGraphFamily*)malloc(sizeof(CloudGraphFamily));
-  // If we could allocate memory
-  if (ret != NULL) {
-    ret->_pos = VecFloatCreate(2);
-    ret->_right = VecFloatCreate(2);
-    if (ret->_pos == NULL || ret->_right == NULL) {
-      VecFree(&(ret->_pos));
-      VecFree(&(ret->_right));
-      free(ret);
-      return NULL;
-    }
-    ret->_id = 0;
-    ret->_rgba[0] = ret->_rgba[1] = ret->_rgba[2] = 0;
-    ret->_rgba[3] = 255;
-    ret->_label = NULL;
-    ret->_boundingBox = NULL;
-  }
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphFamilyInit(ret);
+  return ret;
+}
+
+// Create a CloudGraphFamily with default values (see 
+// CloudGraphCreateFamily) in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphFamily* CloudGraphArenaCreateFamily(CloudGraph *cloud) {
+  // Allocate memory in the arena
+  CloudGraphFamily *ret = (CloudGraphFamily*)CloudGraphArenaAlloc(
+    cloud, sizeof(CloudGraphFamily));
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphFamilyInit(ret);
+  return ret;
+}
+
+// Create 'nb' contiguous CloudGraphFamily with default values in the 
+// arena of 'cloud' with a single allocation
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphFamily* CloudGraphArenaCreateFamilies(CloudGraph *cloud, 
+  int nb) {
+  // Check arguments
+  if (nb <= 0)
+    return NULL;
+  // Allocate memory in the arena
+  CloudGraphFamily *ret = (CloudGraphFamily*)CloudGraphArenaAlloc(
+    cloud, sizeof(CloudGraphFamily) * (size_t)nb);
+  if (ret == NULL)
+    return NULL;
+  // Set the default values
+  for (int iFamily = 0; iFamily < nb; ++iFamily)
+    CloudGraphFamilyInit(ret + iFamily);
   return ret;
 }
 
+// Set the default values of the family, its geometry is set by the 
+// arrangement
+void CloudGraphFamilyInit(CloudGraphFamily *family) {
+  memset(family, 0, sizeof(CloudGraphFamily));
+  family->_rgba[3] = 255;
+}
+
 // Add a copy of the family 'f' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
+// The families are indexed by their ID, the memory of the index is 
+// proportional to the greatest ID, IDs should be dense
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed
 // else return true
 bool CloudGraphAddFamily(CloudGraph *cloud, CloudGraphFamily *f) {
   // Check arguments
-  if (cloud == NULL || f == NULL || cloud->_families == NULL)
+  if (cloud == NULL || f == NULL || cloud->_families == NULL ||
+    f->_id < 0)
     return false;
   // Check that this family doesn't exist yet
-  GSetElem *ptr = cloud->_families->_head;
-  while (ptr != NULL) {
-    // If the ID of the family to add is already used
-    if (f->_id == ((CloudGraphFamily*)(ptr->_data))->_id)
-      // Stop here
-      return false;
-    ptr = ptr->_next;
-  }
-  // Allocate memory for the copy of the family
-  CloudGraphFamily *family = CloudGraphCreateFamily();
+  if (CloudGraphGetFamily(cloud, f->_id) != NULL)
+    return false;
+  // Allocate memory for the copy of the family in the arena
+  CloudGraphFamily *family = CloudGraphArenaCreateFamily(cloud);
   // If we couldn't allocate memory
   if (family == NULL)
     // Stop here
     return false;
+  // Copy the data and add the copy to the CloudGraph
+  if (CloudGraphCopyFamily(cloud, family, f) == false ||
+    CloudGraphAppendFamily(cloud, family) == false) {
+    // Free memory
+    CloudGraphReleaseFamily(cloud, &family);
+    // Stop here
+    return false;
+  }
+  // Return the success code
+  return true;
+}
+
+// Copy the data of the family 'src' into 'dst' created in the arena 
+// of 'cloud', the label is copied in the arena
+// Return false if memory allocation failed, else return true
+bool CloudGraphCopyFamily(CloudGraph *cloud, CloudGraphFamily *dst, 
+  CloudGraphFamily *src) {
   // Copy the data
-  family->_id = f->_id;
+  dst->_id = src->_id;
   for (int iRGB = 4; iRGB--;)
-    family->_rgba[iRGB] = f->_rgba[iRGB];
-  VecCopy(family->_pos, f->_pos);
-  VecCopy(family->_right, f->_right);
+    dst->_rgba[iRGB] = src->_rgba[iRGB];
+  dst->_pos[0] = src->_pos[0];
+  dst->_pos[1] = src->_pos[1];
+  dst->_right[0] = src->_right[0];
+  dst->_right[1] = src->_right[1];
+  dst->_boundingBox = src->_boundingBox;
   // If there is a label
-  if (f->_label != NULL) {
-    // Allocate memory for the copy of the label
-    family->_label = 
-      (char*)malloc(sizeof(char) * (1 + strlen(f->_label)));
+  if (src->_label != NULL) {
+    // Copy the label in the arena
+    dst->_label = CloudGraphArenaCopyString(cloud, src->_label);
     // If we couldn't allocate memory
-    if (family->_label == NULL) {
-      //Free memory
-      free(family);
+    if (dst->_label == NULL)
       // Stop here
       return false;
-    }
-    // Copy the label
-    memcpy(family->_label, f->_label, 
-      sizeof(char) * (1 + strlen(f->_label)));
   }
-  // If there is a boundig box
-  ShapoidFree(&(family->_boundingBox));
-  if (f->_boundingBox != NULL) {
-    family->_boundingBox = ShapoidClone(f->_boundingBox);
-    if (family->_boundingBox == NULL) {
-      CloudGraphFamilyFree(&family);
+  // Return the success code
+  return true;
+}
+
+// Add the family '*f' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*f' is set to NULL
+// '*f' must have been created with CloudGraphCreateFamily and its
+// label, if any, allocated with malloc
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of '*f', else return true
+bool CloudGraphTakeFamily(CloudGraph *cloud, CloudGraphFamily **f) {
+  // Check arguments
+  if (f == NULL || *f == NULL)
+    return false;
+  // Add the family itself to the CloudGraph
+  if (CloudGraphAppendFamily(cloud, *f) == false)
+    return false;
+  // The family now belongs to the CloudGraph
+  *f = NULL;
+  // Return the success code
+  return true;
+}
+
+// Add a copy of the 'nb' families 'f' to the CloudGraph, in the order
+// of the array
+// The memory for the copies and the index of families are reserved at
+// once for all the families
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the families before the one which couldn't be added stay in the
+// CloudGraph, else return true
+bool CloudGraphAddFamilies(CloudGraph *cloud, CloudGraphFamily **f,
+  int nb) {
+  // Check arguments
+  if (cloud == NULL || f == NULL || nb < 0)
+    return false;
+  // If there is nothing to add
+  if (nb == 0)
+    return true;
+  // Check the families and get the greatest ID
+  int maxId = -1;
+  for (int iFamily = 0; iFamily < nb; ++iFamily) {
+    if (f[iFamily] == NULL || f[iFamily]->_id < 0)
+      return false;
+    if (f[iFamily]->_id > maxId)
+      maxId = f[iFamily]->_id;
+  }
+  // Reserve the index of families and the copies at once
+  if (CloudGraphReserveFamilyIndex(cloud, maxId) == false)
+    return false;
+  CloudGraphFamily *families = 
+    CloudGraphArenaCreateFamilies(cloud, nb);
+  if (families == NULL)
+    return false;
+  // For each family
+  for (int iFamily = 0; iFamily < nb; ++iFamily) {
+    // Copy the data and add the copy to the CloudGraph
+    if (CloudGraphCopyFamily(cloud, families + iFamily, 
+      f[iFamily]) == false ||
+      CloudGraphAppendFamily(cloud, families + iFamily) == false) {
+      // Free the objects the copies not added refer to
+      for (int jFamily = iFamily; jFamily < nb; ++jFamily) {
+        CloudGraphFamily *family = families + jFamily;
+        CloudGraphReleaseFamily(cloud, &family);
+      }
+      // Stop here
       return false;
     }
   }
-  // Add the family to the GSet
+  // Return the success code
+  return true;
+}
+
+// Add the family 'family' itself to the CloudGraph, the CloudGraph 
+// takes ownership of it
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of 'family', else return true
+bool CloudGraphAppendFamily(CloudGraph *cloud, CloudGraphFamily *family) {
+  // Check arguments
+  if (cloud == NULL || family == NULL || family->_id < 0)
+    return false;
+  // Check that this family doesn't exist yet
+  if (CloudGraphGetFamily(cloud, family->_id) != NULL)
+    return false;
+  // Ensure there is room in the index for this family
+  if (CloudGraphReserveFamilyIndex(cloud, family->_id) == false)
+    return false;
+  // Add the family to the GSet, the nodes of this family may move and
+  // its label is placed by the next arrangement
   GSetAppend(cloud->_families, family);
+  if (CloudGraphArenaOwns(cloud, family) == false)
+    ++(cloud->_nbOwned);
+  cloud->_cols._valid = false;
+  cloud->_dirty._relayout = true;
+  CloudGraphInvalidateViews(cloud);
+  // Add the family to the index
+  cloud->_familyIndex[family->_id] = family;
+  if (family->_id >= cloud->_familyIndexSize)
+    cloud->_familyIndexSize = family->_id + 1;
   // Return the success code
   return true;
 }
 
+// Ensure the index of families can hold the ID 'id'
+// The index has one entry per ID up to the greatest one, its memory 
+// is proportional to the greatest ID
+// Return false if arguments are invalid, if 'id' can't be indexed 
+// (INT_MAX) or memory allocation failed, else return true
+bool CloudGraphReserveFamilyIndex(CloudGraph *cloud, int id) {
+  // Check arguments
+  if (cloud == NULL || id < 0 || id == INT_MAX)
+    return false;
+  // If the index is already large enough
+  if (id < cloud->_familyIndexCapacity)
+    // Nothing to do
+    return true;
+  // Double the capacity until it can hold the ID, to keep the 
+  // amortized cost of adding families constant, up to INT_MAX
+  size_t capacity = (cloud->_familyIndexCapacity > 0 ? 
+    (size_t)(cloud->_familyIndexCapacity) : 16);
+  while (capacity <= (size_t)id)
+    capacity *= 2;
+  if (capacity > INT_MAX)
+    capacity = INT_MAX;
+  if (capacity > SIZE_MAX / sizeof(CloudGraphFamily*))
+    return false;
+  // Reallocate the index
+  CloudGraphFamily **index = (CloudGraphFamily**)realloc(
+    cloud->_familyIndex, sizeof(CloudGraphFamily*) * capacity);
+  // If we couldn't allocate memory
+  if (index == NULL)
+    // Stop here, the current index is left untouched
+    return false;
+  // Set the new entries to empty
+  for (int iId = cloud->_familyIndexCapacity; iId < (int)capacity; 
+    ++iId)
+    index[iId] = NULL;
+  // Update the index
+  cloud->_familyIndex = index;
+  cloud->_familyIndexCapacity = (int)capacity;
+  // Return success code
+  return true;
+}
+
 // Create a CloudGraphNode with default values:
 // _id = 0
 // _family = 0
@@ -383,300 +1687,1188 @@ bool CloudGraphAddFamily(CloudGraph *cloud, CloudGraphFamily *f) {
 CloudGraphNode* CloudGraphCreateNode(void) {
   // Allocate memory
   CloudGraphNode *ret = (CloudGraphNode*)malloc(sizeof(CloudGraphNode));
-  // If we could allocate memory
-  if (ret != NULL) {
-    ret->_pos = VecFloatCreate(2);
-    ret->_right = VecFloatCreate(2);
-    ret->_boundingBox = FacoidCreate(2);
-    if (ret->_pos == NULL || ret->_right == NULL || 
-      ret->_boundingBox == NULL) {
-      VecFree(&(ret->_pos));
-      VecFree(&(ret->_right));
-      ShapoidFree(&(ret->_boundingBox));
-      free(ret);
-      return NULL;
-    }
-    ret->_id = 0;
-    ret->_family = 0;
-    ret->_label = NULL;
-    ret->_boundingBoxLbl = NULL;
-  }
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphNodeInit(ret);
+  return ret;
+}
+
+// Create a CloudGraphNode with default values (see 
+// CloudGraphCreateNode) in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphNode* CloudGraphArenaCreateNode(CloudGraph *cloud) {
+  // Allocate memory in the arena
+  CloudGraphNode *ret = (CloudGraphNode*)CloudGraphArenaAlloc(cloud, 
+    sizeof(CloudGraphNode));
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphNodeInit(ret);
+  return ret;
+}
+
+// Create 'nb' contiguous CloudGraphNode with default values in the 
+// arena of 'cloud' with a single allocation
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphNode* CloudGraphArenaCreateNodes(CloudGraph *cloud, int nb) {
+  // Check arguments
+  if (nb <= 0)
+    return NULL;
+  // Allocate memory in the arena
+  CloudGraphNode *ret = (CloudGraphNode*)CloudGraphArenaAlloc(cloud, 
+    sizeof(CloudGraphNode) * (size_t)nb);
+  if (ret == NULL)
+    return NULL;
+  // Set the default values
+  for (int iNode = 0; iNode < nb; ++iNode)
+    CloudGraphNodeInit(ret + iNode);
   return ret;
 }
 
+// Set the default values of the node, its geometry is set by the 
+// arrangement
+void CloudGraphNodeInit(CloudGraphNode *node) {
+  memset(node, 0, sizeof(CloudGraphNode));
+}
+
 // Add a copy of the node 'n' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
+// The nodes are indexed by their ID, the memory of the index is 
+// proportional to the greatest ID, IDs should be dense
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed
 // else return true
 bool CloudGraphAddNode(CloudGraph *cloud, CloudGraphNode *n) {
   // Check arguments
-  if (cloud == NULL || n == NULL)
+  if (cloud == NULL || n == NULL || n->_id < 0)
+    return false;
+  // Check that this node doesn't exist yet
+  if (CloudGraphGetNode(cloud, n->_id) != NULL)
     return false;
-  // Create the node to add
-  CloudGraphNode *node = CloudGraphCreateNode();
+  // Create the node to add in the arena
+  CloudGraphNode *node = CloudGraphArenaCreateNode(cloud);
   // If we couldn't allocate memory
   if (node == NULL)
     // Stop here
     return false;
+  // Copy the data of the node and add the copy to the CloudGraph
+  if (CloudGraphCopyNode(cloud, node, n) == false ||
+    CloudGraphAppendNode(cloud, node) == false) {
+    // Free memory
+    CloudGraphReleaseNode(cloud, &node);
+    // Stop here
+    return false;
+  }
+  // Return success code
+  return true;
+}
+
+// Copy the data of the node 'src' into 'dst' created in the arena of 
+// 'cloud', the label is copied in the arena
+// Return false if memory allocation failed, else return true
+bool CloudGraphCopyNode(CloudGraph *cloud, CloudGraphNode *dst, 
+  CloudGraphNode *src) {
   // Copy the data of the node
-  node->_id = n->_id;
-  node->_family = n->_family;
-  VecCopy(node->_pos, n->_pos);
-  VecCopy(node->_right, n->_right);
+  dst->_id = src->_id;
+  dst->_family = src->_family;
+  dst->_pos[0] = src->_pos[0];
+  dst->_pos[1] = src->_pos[1];
+  dst->_right[0] = src->_right[0];
+  dst->_right[1] = src->_right[1];
+  dst->_boundingBox = src->_boundingBox;
+  dst->_boundingBoxLbl = src->_boundingBoxLbl;
   // If there is a label
-  if (n->_label != NULL) {
-    // Allocate memory for the label of the node
-    node->_label = 
-      (char*)malloc(sizeof(char) * (strlen(n->_label) + 1));
+  if (src->_label != NULL) {
+    // Copy the label of the node in the arena
+    dst->_label = CloudGraphArenaCopyString(cloud, src->_label);
     // If we couldn't allocate memory
-    if (node->_label == NULL) {
-      // Free memory
-      CloudGraphNodeFree(&node);
+    if (dst->_label == NULL)
       // Stop here
       return false;
-    }
-    // Copy the label
-    memcpy(node->_label, n->_label, 
-      sizeof(char) * (strlen(n->_label) + 1));
   }
-  ShapoidFree(&(node->_boundingBox));
-  node->_boundingBox = ShapoidClone(n->_boundingBox);
-  if (node->_boundingBox == NULL) {
-    CloudGraphNodeFree(&node);
+  // Return success code
+  return true;
+}
+
+// Add the node '*n' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*n' is set to NULL
+// '*n' must have been created with CloudGraphCreateNode and its
+// label, if any, allocated with malloc
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of '*n', else return true
+bool CloudGraphTakeNode(CloudGraph *cloud, CloudGraphNode **n) {
+  // Check arguments
+  if (n == NULL || *n == NULL)
+    return false;
+  // Add the node itself to the CloudGraph
+  if (CloudGraphAppendNode(cloud, *n) == false)
     return false;
+  // The node now belongs to the CloudGraph
+  *n = NULL;
+  // Return success code
+  return true;
+}
+
+// Add a copy of the 'nb' nodes 'n' to the CloudGraph, in the order of
+// the array
+// The memory for the copies and the index of nodes are reserved at
+// once for all the nodes
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the nodes before the one which couldn't be added stay in the
+// CloudGraph, else return true
+bool CloudGraphAddNodes(CloudGraph *cloud, CloudGraphNode **n, int nb) {
+  // Check arguments
+  if (cloud == NULL || n == NULL || nb < 0)
+    return false;
+  // If there is nothing to add
+  if (nb == 0)
+    return true;
+  // Check the nodes and get the greatest ID
+  int maxId = -1;
+  for (int iNode = 0; iNode < nb; ++iNode) {
+    if (n[iNode] == NULL || n[iNode]->_id < 0)
+      return false;
+    if (n[iNode]->_id > maxId)
+      maxId = n[iNode]->_id;
   }
-  // If there is a bounding box for the label
-  if (n->_boundingBoxLbl != NULL) {
-    node->_boundingBoxLbl = ShapoidClone(n->_boundingBoxLbl);
-    if (node->_boundingBoxLbl == NULL) {
-      CloudGraphNodeFree(&node);
+  // Reserve the index of nodes and the copies at once
+  if (CloudGraphReserveNodeIndex(cloud, maxId) == false)
+    return false;
+  CloudGraphNode *nodes = CloudGraphArenaCreateNodes(cloud, nb);
+  if (nodes == NULL)
+    return false;
+  // For each node
+  for (int iNode = 0; iNode < nb; ++iNode) {
+    // Copy the data and add the copy to the CloudGraph
+    if (CloudGraphCopyNode(cloud, nodes + iNode, n[iNode]) == false ||
+      CloudGraphAppendNode(cloud, nodes + iNode) == false) {
+      // Free the objects the copies not added refer to
+      for (int jNode = iNode; jNode < nb; ++jNode) {
+        CloudGraphNode *node = nodes + jNode;
+        CloudGraphReleaseNode(cloud, &node);
+      }
+      // Stop here
       return false;
     }
   }
-  // Add the node to the set
+  // Return success code
+  return true;
+}
+
+// Add the node 'node' itself to the CloudGraph, the CloudGraph takes 
+// ownership of it
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of 'node', else return true
+bool CloudGraphAppendNode(CloudGraph *cloud, CloudGraphNode *node) {
+  // Check arguments
+  if (cloud == NULL || node == NULL || node->_id < 0)
+    return false;
+  // Check that this node doesn't exist yet
+  if (CloudGraphGetNode(cloud, node->_id) != NULL)
+    return false;
+  // Ensure there is room in the index for this node
+  if (CloudGraphReserveNodeIndex(cloud, node->_id) == false)
+    return false;
+  // Add the node to the set, the nodes after it in the arrangement 
+  // will move
   GSetAppend(cloud->_nodes, node);
+  node->_elem = cloud->_nodes->_tail;
+  if (CloudGraphArenaOwns(cloud, node) == false)
+    ++(cloud->_nbOwned);
+  cloud->_cols._valid = false;
+  cloud->_dirty._relayout = true;
+  CloudGraphInvalidateViews(cloud);
+  // Add the node to the index and the adjacency
+  cloud->_nodeIndex[node->_id] = node;
+  if (node->_id >= cloud->_nodeIndexSize)
+    cloud->_nodeIndexSize = node->_id + 1;
+  CloudGraphAdjacencyAddNode(cloud, node->_id);
+  // Return success code
+  return true;
+}
+
+// Ensure the index of nodes can hold the ID 'id'
+// The index has one entry per ID up to the greatest one, its memory 
+// is proportional to the greatest ID
+// Return false if arguments are invalid, if 'id' can't be indexed 
+// (INT_MAX) or memory allocation failed, else return true
+bool CloudGraphReserveNodeIndex(CloudGraph *cloud, int id) {
+  // Check arguments
+  if (cloud == NULL || id < 0 || id == INT_MAX)
+    return false;
+  // If the index is already large enough
+  if (id < cloud->_nodeIndexCapacity)
+    // Nothing to do
+    return true;
+  // Double the capacity until it can hold the ID, to keep the 
+  // amortized cost of adding nodes constant, up to INT_MAX
+  size_t capacity = (cloud->_nodeIndexCapacity > 0 ? 
+    (size_t)(cloud->_nodeIndexCapacity) : 16);
+  while (capacity <= (size_t)id)
+    capacity *= 2;
+  if (capacity > INT_MAX)
+    capacity = INT_MAX;
+  if (capacity > SIZE_MAX / sizeof(CloudGraphNode*))
+    return false;
+  // Reallocate the index
+  CloudGraphNode **index = (CloudGraphNode**)realloc(cloud->_nodeIndex,
+    sizeof(CloudGraphNode*) * capacity);
+  // If we couldn't allocate memory
+  if (index == NULL)
+    // Stop here, the current index is left untouched
+    return false;
+  // Set the new entries to empty
+  for (int iId = cloud->_nodeIndexCapacity; iId < (int)capacity; ++iId)
+    index[iId] = NULL;
+  // Update the index
+  cloud->_nodeIndex = index;
+  cloud->_nodeIndexCapacity = (int)capacity;
   // Return success code
   return true;
 }
 
 // Create a CloudGraphLink with default values:
 // _nodes[0] = _nodes[1] = -1
+// _weight = 1
 // Return NULL if couldn't create the link
 CloudGraphLink* CloudGraphCreateLink(void) {
   // Allocate memory
   CloudGraphLink *ret = (CloudGraphLink*)malloc(sizeof(CloudGraphLink));
-  // If we could allocate memory
-  if (ret != NULL) {
-    // Set the properties
-    ret->_nodes[0] = ret->_nodes[1] = -1;
-    ret->_boundingBox = NULL;
-    // Create the curve
-    ret->_curve = BCurveCreate(3, 2);
-    if (ret->_curve == NULL)
-      CloudGraphLinkFree(&ret);
-  }
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphLinkInit(ret, false);
+  return ret;
+}
+
+// Create a CloudGraphLink with default values (see 
+// CloudGraphCreateLink) in the arena of 'cloud'
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphLink* CloudGraphArenaCreateLink(CloudGraph *cloud) {
+  // Allocate memory in the arena
+  CloudGraphLink *ret = (CloudGraphLink*)CloudGraphArenaAlloc(cloud, 
+    sizeof(CloudGraphLink));
+  // If we could allocate memory, set the default values
+  if (ret != NULL)
+    CloudGraphLinkInit(ret, cloud->_lazyLinks);
+  return ret;
+}
+
+// Create 'nb' contiguous CloudGraphLink with default values in the 
+// arena of 'cloud' with a single allocation
+// Return NULL if arguments are invalid or memory allocation failed
+CloudGraphLink* CloudGraphArenaCreateLinks(CloudGraph *cloud, int nb) {
+  // Check arguments
+  if (nb <= 0)
+    return NULL;
+  // Allocate memory in the arena
+  CloudGraphLink *ret = (CloudGraphLink*)CloudGraphArenaAlloc(cloud, 
+    sizeof(CloudGraphLink) * (size_t)nb);
+  if (ret == NULL)
+    return NULL;
+  // Set the default values
+  for (int iLink = 0; iLink < nb; ++iLink)
+    CloudGraphLinkInit(ret + iLink, cloud->_lazyLinks);
   return ret;
 }
 
+// Set the default values of the link, it is lazy if 'lazy' is true,
+// its geometry is set by the arrangement
+void CloudGraphLinkInit(CloudGraphLink *link, bool lazy) {
+  memset(link, 0, sizeof(CloudGraphLink));
+  link->_nodes[0] = link->_nodes[1] = -1;
+  link->_weight = 1;
+  link->_lazy = lazy;
+  link->_col = -1;
+}
+
 // Add a copy of the link 'l' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
-// else return true
+// If the CloudGraph bundles its links and already has a link between 
+// the same two nodes, the weight of 'l' is added to the weight of 
+// this link instead
+// Return false if the arguments are invalid (including a weight lower
+// than 1) or memory allocation failed, else return true
 bool CloudGraphAddLink(CloudGraph *cloud, CloudGraphLink *l) {
   // Check arguments
   if (cloud == NULL || l == NULL || cloud->_links == NULL ||
-    l->_nodes[0] == l->_nodes[1])
+    l->_nodes[0] == l->_nodes[1] || l->_weight < 1)
     return false;
-  // Allocate memory for the copy of the link
-  CloudGraphLink *link = CloudGraphCreateLink();
+  // If the link can be bundled into a link already in the CloudGraph
+  // there is no copy to make
+  if (CloudGraphAddToBundle(cloud, l->_nodes[0], l->_nodes[1], 
+    l->_weight))
+    return true;
+  // Allocate memory for the copy of the link in the arena
+  CloudGraphLink *link = CloudGraphArenaCreateLink(cloud);
   // If we couldn't allocate memory
   if (link == NULL)
     // Stop here
     return false;
+  // Copy the data and add the copy to the CloudGraph
+  CloudGraphCopyLink(link, l);
+  if (CloudGraphAppendLink(cloud, link) == false) {
+    CloudGraphReleaseLink(cloud, &link);
+    return false;
+  }
+  // Return success code
+  return true;
+}
+
+// Copy the data of the link 'src' into 'dst'
+// The control points and bounding box are not copied if one of the 
+// links is lazy
+void CloudGraphCopyLink(CloudGraphLink *dst, CloudGraphLink *src) {
   // Copy the data
   for (int iNode = 2; iNode--;) {
-    link->_nodes[iNode] = l->_nodes[iNode];
-    link->_families[iNode] = l->_families[iNode];
+    dst->_nodes[iNode] = src->_nodes[iNode];
+    dst->_families[iNode] = src->_families[iNode];
   }
-  BCurveFree(&(link->_curve));
-  link->_curve = BCurveClone(l->_curve);
-  if (link->_curve == NULL) {
-    CloudGraphLinkFree(&link);
+  dst->_weight = src->_weight;
+  if (dst->_lazy == false && src->_lazy == false) {
+    memcpy(dst->_ctrl, src->_ctrl, sizeof(dst->_ctrl));
+    dst->_boundingBox = src->_boundingBox;
+  }
+}
+
+// Add the link 'link' itself to the CloudGraph, the CloudGraph takes 
+// ownership of it
+// If the CloudGraph bundles its links and already has a link between
+// the same nodes, the weight of 'link' is added to this link and 
+// 'link' is released
+// Return false if the arguments are invalid or memory allocation 
+// failed, in which case the caller keeps the ownership of 'link', 
+// else return true
+bool CloudGraphAppendLink(CloudGraph *cloud, CloudGraphLink *link) {
+  // Check arguments
+  if (cloud == NULL || link == NULL || cloud->_links == NULL ||
+    link->_nodes[0] == link->_nodes[1] || link->_weight < 1)
     return false;
+  // If the links are bundled
+  if (cloud->_bundleLinks) {
+    // If the link can be bundled into a link already in the CloudGraph
+    if (CloudGraphAddToBundle(cloud, link->_nodes[0], link->_nodes[1],
+      link->_weight)) {
+      // The link is not needed anymore
+      CloudGraphReleaseLink(cloud, &link);
+      return true;
+    }
+    // Add the link to the set of links
+    if (CloudGraphLinkSetReserve(&(cloud->_linkSet), 
+      cloud->_linkSet._nb + 1) == false)
+      return false;
+    CloudGraphLinkSetInsert(&(cloud->_linkSet), link);
   }
   // Add the link to the set
   GSetAppend(cloud->_links, link);
+  link->_elem = cloud->_links->_tail;
+  link->_dirty = true;
+  if (CloudGraphArenaOwns(cloud, link) == false)
+    ++(cloud->_nbOwned);
+  // If the changes are tracked, add the link to the columns, else they
+  // will be rebuilt
+  if (CloudGraphTrackLink(cloud, link) == false) {
+    cloud->_cols._valid = false;
+    cloud->_dirty._relayout = true;
+  }
+  // Add the link to the adjacency
+  CloudGraphAdjacencyAddLink(cloud, link);
+  CloudGraphInvalidateViews(cloud);
   // Return success code
   return true;
 }
 
-// Load the CloudGraph from 'stream'
-// If 'cloud' is not NULL it is first freed
-// Return 0 on success
-// 1: invalid arguments
-// 2: can't allocate memory
-// 3: invalid data
-// 4: fscanf error
-int CloudGraphLoad(CloudGraph **cloud, FILE *stream) {
-  // Check arguments
-  if (*cloud == NULL || stream == NULL)
-    return 1;
-  // If cloud already exists
-  if (*cloud != NULL)
-    // Free it
-    CloudGraphFree(cloud);
-  // Create the cloud
-  *cloud = CloudGraphCreate();
-  // Create a family
-  CloudGraphFamily *family = CloudGraphCreateFamily();
-  // Create a node
-  CloudGraphNode *node = CloudGraphCreateNode();
-  // Create a link
-  CloudGraphLink *link = CloudGraphCreateLink();
-  // If we couldn't allocate memory
-  if (*cloud == NULL || family == NULL || node == NULL || 
-    link == NULL) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 2;
+// Add the link 'link', just added to the set of links of 'cloud', to
+// the columns and the dirty links of 'cloud' if its changes are 
+// tracked
+// Return false if the changes are not tracked or memory allocation 
+// failed, in which case the columns must be rebuilt, else return true
+bool CloudGraphTrackLink(CloudGraph *cloud, CloudGraphLink *link) {
+  // Declare pointers to the columns and the changes
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphDirty *dirty = &(cloud->_dirty);
+  // If the changes are not tracked
+  if (dirty->_tracked == false || cols->_valid == false)
+    return false;
+  // Ensure the columns and the dirty links can hold the link
+  if (CloudGraphColumnsReserve(cols, cols->_nbNode, cols->_nbLink + 1, 
+    cloud->_nodeIndexSize) == false)
+    return false;
+  if (dirty->_nbLink == dirty->_capacityLink) {
+    int capacity = 2 * dirty->_capacityLink + 16;
+    if (CloudGraphRealloc((void**)&(dirty->_links), 
+      sizeof(int) * capacity) == false)
+      return false;
+    dirty->_capacityLink = capacity;
   }
-  // Set the opacity of the family color
-  family->_rgba[3] = 255;
-  // Allocate memory for the family and node label
-  // The local family and node are just used to here as an argument
-  // the proper amount of memory will be allocated when they are 
-  // added to the cloud
-  family->_label = 
-    (char*)malloc(sizeof(char) * CLOUDGRAPH_MAXLENGTHLABEL);
-  node->_label = 
-    (char*)malloc(sizeof(char) * CLOUDGRAPH_MAXLENGTHLABEL);
-  if (family->_label == NULL || node->_label == NULL) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 2;
+  // Add the link at the end of the columns, links toward unknown nodes
+  // get -1 as in CloudGraphUpdateColumns
+  int iLink = cols->_nbLink;
+  cols->_link[iLink] = link;
+  link->_col = iLink;
+  cols->_from[iLink] = (link->_nodes[0] >= 0 && 
+    link->_nodes[0] < cloud->_nodeIndexSize ? 
+    cols->_col[link->_nodes[0]] : -1);
+  cols->_to[iLink] = (link->_nodes[1] >= 0 && 
+    link->_nodes[1] < cloud->_nodeIndexSize ? 
+    cols->_col[link->_nodes[1]] : -1);
+  cols->_c1x[iLink] = cols->_c1y[iLink] = 0.0;
+  cols->_c2x[iLink] = cols->_c2y[iLink] = 0.0;
+  ++(cols->_nbLink);
+  // Memorize the link as dirty
+  dirty->_links[dirty->_nbLink] = iLink;
+  ++(dirty->_nbLink);
+  // Return success code
+  return true;
+}
+
+// Remove the node 'id' and its links from the CloudGraph
+// Return false if arguments are invalid (including an unknown node)
+// else return true
+bool CloudGraphRemoveNode(CloudGraph *cloud, int id) {
+  // Get the node
+  CloudGraphNode *node = CloudGraphGetNode(cloud, id);
+  if (node == NULL)
+    return false;
+  // The nodes after this one in the arrangement will move, the columns
+  // are rebuilt and all the nodes placed again
+  cloud->_cols._valid = false;
+  cloud->_dirty._relayout = true;
+  CloudGraphInvalidateViews(cloud);
+  // Remove the links of the node in its row of the adjacency, from the
+  // end of the row as each removal moves the last neighbor of the row
+  bool searchLinks = true;
+  if (CloudGraphEnsureAdjacency(cloud)) {
+    CloudGraphAdjacency *adj = &(cloud->_adj);
+    while (adj->_valid && adj->_degree[id] > 0)
+      CloudGraphDeleteLink(cloud, 
+        adj->_links[adj->_offsets[id] + adj->_degree[id] - 1], -1);
+    // The links toward unknown nodes are not in the rows, they are 
+    // searched only if there are some
+    searchLinks = (adj->_valid == false || adj->_nbIgnored > 0);
   }
-  // Declare a variable to read the rgb
-  int rgb[3] = {0};
-  // Read the number of families
-  int nbFamily = 0;
-  int ret = fscanf(stream, "%d", &nbFamily);
-  // If the fscanf failed
-  if (ret == EOF) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 4;
+  // If some links of the node may be outside its row, search them in 
+  // the set of links
+  if (searchLinks) {
+    GSetElem *ptr = cloud->_links->_head;
+    while (ptr != NULL) {
+      CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+      ptr = ptr->_next;
+      if (link->_nodes[0] == id || link->_nodes[1] == id)
+        CloudGraphDeleteLink(cloud, link, -1);
+    }
   }
-  // If the number of family is invalid
-  if (nbFamily <= 0) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 3;
+  // Remove the node from the set of nodes
+  GSetRemoveElem(cloud->_nodes, &(node->_elem));
+  // Remove the node from the index and release it
+  cloud->_nodeIndex[id] = NULL;
+  if (CloudGraphArenaOwns(cloud, node) == false)
+    --(cloud->_nbOwned);
+  CloudGraphReleaseNode(cloud, &node);
+  // Return success code
+  return true;
+}
+
+// Remove one link between the nodes 'from' and 'to', in any 
+// direction, from the CloudGraph
+// If the link is a bundle of several links (see 
+// CloudGraphSetBundleLinks, bundles are kept when the CloudGraph 
+// stops bundling its links), its weight is decreased, else it is 
+// removed
+// The link is searched with the set of links if the CloudGraph 
+// bundles its links, else in the adjacency of 'from' (see 
+// CloudGraphGetNeighbors), and its position in the columns is the one
+// memorized in the link
+// Return false if arguments are invalid (including no link between 
+// the nodes), else return true
+bool CloudGraphRemoveLink(CloudGraph *cloud, int from, int to) {
+  // Check arguments
+  if (cloud == NULL || from == to)
+    return false;
+  // Search the link
+  CloudGraphLink *link = CloudGraphFindLink(cloud, from, to);
+  // If there is no such link
+  if (link == NULL)
+    return false;
+  // If the link is a bundle of several links
+  if (link->_weight > 1) {
+    // Remove one link from the bundle, the geometry is unchanged
+    --(link->_weight);
+    CloudGraphInvalidateViews(cloud);
+    return true;
   }
-  // For each family
-  for (int iFamily = nbFamily; iFamily--;) {
-    // Read the family properties
-    ret = fscanf(stream, "%d %d %d %d ",
-      &(family->_id), rgb, rgb + 1, rgb + 2);
-    // Check values
-    if (ret == EOF || family->_id < 0 || family->_id >= nbFamily ||
-      rgb[0] < 0 || rgb[0] > 255 || rgb[1] < 0 || rgb[1] > 255 || 
-      rgb[2] < 0 || rgb[2] > 255) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
-    }
-    if (fgets(family->_label, CLOUDGRAPH_MAXLENGTHLABEL, 
-      stream) == NULL) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
-    }
-    // Remove the line return
-    family->_label[strlen(family->_label) - 1] = '\0';
-    // Convert rgb values
-    for (int iRgb = 3; iRgb--;)
-      family->_rgba[iRgb] = rgb[iRgb];
-    // Add the family to the cloud
-    if (CloudGraphAddFamily(*cloud, family) == false) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
-    }
+  // Remove the link, at its position in the columns if they are up to
+  // date
+  CloudGraphDeleteLink(cloud, link, 
+    (cloud->_cols._valid ? link->_col : -1));
+  // Return success code
+  return true;
+}
+
+// Return a link of 'cloud' between the nodes 'from' and 'to', in any
+// direction, or NULL if there is no such link
+// The link is searched in the set of links if the CloudGraph bundles 
+// its links, else in the row of 'from' in the adjacency, in 
+// O(degree of 'from') if the adjacency is up to date, else in the 
+// list of links
+CloudGraphLink* CloudGraphFindLink(CloudGraph *cloud, int from, int to) {
+  // If the links are bundled, search the set of links
+  if (cloud->_bundleLinks) {
+    if (cloud->_linkSet._nb == 0)
+      return NULL;
+    return cloud->_linkSet._slots[
+      CloudGraphLinkSetSlot(&(cloud->_linkSet), from, to)];
   }
-  // Read the number of nodes
-  int nbNode = 0;
-  ret = fscanf(stream, "%d", &nbNode);
-  // If the fscanf failed
-  if (ret == EOF) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 4;
+  // If both nodes exist, the link is in the adjacency
+  if (CloudGraphGetNode(cloud, from) != NULL &&
+    CloudGraphGetNode(cloud, to) != NULL &&
+    CloudGraphEnsureAdjacency(cloud)) {
+    const CloudGraphAdjacency *adj = &(cloud->_adj);
+    for (int iNeighbor = adj->_offsets[from]; 
+      iNeighbor < adj->_offsets[from] + adj->_degree[from]; 
+      ++iNeighbor)
+      if (adj->_neighbors[iNeighbor] == to)
+        return adj->_links[iNeighbor];
+    return NULL;
   }
-  // If the number of node is invalid
-  if (nbNode <= 0) {
-    // Free memory and stop here
-    CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
-    return 3;
+  // Else search the list of links
+  GSetElem *ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    if ((link->_nodes[0] == from && link->_nodes[1] == to) ||
+      (link->_nodes[0] == to && link->_nodes[1] == from))
+      return link;
+    ptr = ptr->_next;
   }
-  // For each node
-  for (int iNode = nbNode; iNode--;) {
-    // Read the node properties
-    ret = fscanf(stream, "%d %d ",
-      &(node->_id), &(node->_family));
-    // Check values
-    if (ret == EOF || node->_id < 0 || node->_id >= nbNode ||
-      node->_family < 0 || node->_family >= nbFamily) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
-    }
-    if (fgets(node->_label, CLOUDGRAPH_MAXLENGTHLABEL, 
-      stream) == NULL) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
-    }
-    // Remove the line return
-    node->_label[strlen(node->_label) - 1] = '\0';
-    // Add the node to the cloud
-    if (CloudGraphAddNode(*cloud, node) == false) {
-      // Free memory and stop here
-      CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
+  return NULL;
+}
+
+// Remove the link 'link' from 'cloud' and release it, 'iCol' is its 
+// position in the columns or -1 if unknown, in which case the 
+// columns will be rebuilt
+void CloudGraphDeleteLink(CloudGraph *cloud, CloudGraphLink *link, 
+  int iCol) {
+  // Remove the link from the set of links and the list of links
+  if (cloud->_bundleLinks)
+    CloudGraphLinkSetRemove(&(cloud->_linkSet), link);
+  GSetRemoveElem(cloud->_links, &(link->_elem));
+  // If the changes are tracked, remove the link from the columns
+  CloudGraphDirty *dirty = &(cloud->_dirty);
+  if (iCol >= 0 && dirty->_tracked && cloud->_cols._valid) {
+    // If the link had been arranged, memorize its bounds, else forget
+    // it is dirty
+    float min[2];
+    float max[2];
+    if (link->_dirty == false) {
+      if (CloudGraphGetLinkBounds(cloud, iCol, min, max)) {
+        for (int iDim = 2; iDim--;) {
+          if (min[iDim] < dirty->_removedMin[iDim])
+            dirty->_removedMin[iDim] = min[iDim];
+          if (max[iDim] > dirty->_removedMax[iDim])
+            dirty->_removedMax[iDim] = max[iDim];
+        }
+      }
+    } else {
+      for (int iDirty = dirty->_nbLink; iDirty--;) {
+        if (dirty->_links[iDirty] == iCol) {
+          dirty->_links[iDirty] = dirty->_links[dirty->_nbLink - 1];
+          --(dirty->_nbLink);
+          break;
+        }
+      }
+    }
+    CloudGraphColumnsRemoveLink(cloud, iCol);
+  } else {
+    cloud->_cols._valid = false;
+    dirty->_relayout = true;
+  }
+  // Remove the link from the adjacency
+  CloudGraphAdjacencyRemoveLink(cloud, link);
+  CloudGraphInvalidateViews(cloud);
+  // Release the link
+  if (CloudGraphArenaOwns(cloud, link) == false)
+    --(cloud->_nbOwned);
+  CloudGraphReleaseLink(cloud, &link);
+}
+
+// Remove the link at position 'iLink' from the columns of 'cloud' by
+// moving the last link in its place
+void CloudGraphColumnsRemoveLink(CloudGraph *cloud, int iLink) {
+  // Declare pointers to the columns and the changes
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphDirty *dirty = &(cloud->_dirty);
+  // Move the last link in place of the removed one
+  int iLast = cols->_nbLink - 1;
+  if (iLink != iLast) {
+    cols->_link[iLink] = cols->_link[iLast];
+    cols->_link[iLink]->_col = iLink;
+    cols->_from[iLink] = cols->_from[iLast];
+    cols->_to[iLink] = cols->_to[iLast];
+    cols->_c1x[iLink] = cols->_c1x[iLast];
+    cols->_c1y[iLink] = cols->_c1y[iLast];
+    cols->_c2x[iLink] = cols->_c2x[iLast];
+    cols->_c2y[iLink] = cols->_c2y[iLast];
+    // If the moved link is dirty, update its position
+    if (cols->_link[iLink]->_dirty)
+      for (int iDirty = dirty->_nbLink; iDirty--;)
+        if (dirty->_links[iDirty] == iLast)
+          dirty->_links[iDirty] = iLink;
+  }
+  --(cols->_nbLink);
+}
+
+// Forget the changes of 'cloud' since the last arrangement, its 
+// columns reflect its new arrangement
+// The dirty flag of the links is cleared if 'allLinks' is true, else
+// the caller must have cleared it for the dirty links
+void CloudGraphResetDirty(CloudGraph *cloud, bool allLinks) {
+  // Declare pointers to the columns and the changes
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphDirty *dirty = &(cloud->_dirty);
+  // The links are all arranged
+  if (allLinks)
+    for (int iLink = 0; iLink < cols->_nbLink; ++iLink)
+      cols->_link[iLink]->_dirty = false;
+  dirty->_nbLink = 0;
+  for (int iDim = 2; iDim--;) {
+    dirty->_removedMin[iDim] = FLT_MAX;
+    dirty->_removedMax[iDim] = -FLT_MAX;
+  }
+  // The next changes can be tracked
+  dirty->_tracked = true;
+  dirty->_relayout = false;
+}
+
+// Add the link '*l' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*l' is set to NULL
+// '*l' must have been created with CloudGraphCreateLink
+// If '*l' is bundled into a link already in the CloudGraph it is freed
+// Return false if the arguments are invalid or memory allocation 
+// failed, in which case the caller keeps the ownership of '*l', else 
+// return true
+bool CloudGraphTakeLink(CloudGraph *cloud, CloudGraphLink **l) {
+  // Check arguments
+  if (l == NULL || *l == NULL)
+    return false;
+  // Add the link itself to the CloudGraph
+  if (CloudGraphAppendLink(cloud, *l) == false)
+    return false;
+  // The link now belongs to the CloudGraph
+  *l = NULL;
+  // Return success code
+  return true;
+}
+
+// Add a copy of the 'nb' links 'l' to the CloudGraph, in the order of
+// the array
+// The memory for the copies is reserved at once for all the links
+// Return false if the arguments are invalid or memory allocation
+// failed, in which case the links before the one which couldn't be
+// added stay in the CloudGraph, else return true
+bool CloudGraphAddLinks(CloudGraph *cloud, CloudGraphLink **l, int nb) {
+  // Check arguments
+  if (cloud == NULL || l == NULL || nb < 0)
+    return false;
+  // If there is nothing to add
+  if (nb == 0)
+    return true;
+  // Check the links
+  for (int iLink = 0; iLink < nb; ++iLink)
+    if (l[iLink] == NULL || l[iLink]->_nodes[0] == l[iLink]->_nodes[1] ||
+      l[iLink]->_weight < 1)
+      return false;
+  // Reserve the copies at once
+  CloudGraphLink *links = CloudGraphArenaCreateLinks(cloud, nb);
+  if (links == NULL)
+    return false;
+  // For each link
+  for (int iLink = 0; iLink < nb; ++iLink) {
+    // Copy the data and add the copy to the CloudGraph
+    CloudGraphCopyLink(links + iLink, l[iLink]);
+    if (CloudGraphAppendLink(cloud, links + iLink) == false) {
+      // Free the objects the copies not added refer to
+      for (int jLink = iLink; jLink < nb; ++jLink) {
+        CloudGraphLink *link = links + jLink;
+        CloudGraphReleaseLink(cloud, &link);
+      }
+      // Stop here
+      return false;
+    }
+  }
+  // Return success code
+  return true;
+}
+
+// Add a link between the nodes 'from' and 'to' to the CloudGraph 
+// 'cloud', the link is created in the arena only if it can't be 
+// bundled into a link already in 'cloud'
+// Return the same codes as CloudGraphLoad
+int CloudGraphAddLinkNodes(CloudGraph *cloud, int from, int to) {
+  // Check arguments
+  if (from == to)
+    return 3;
+  // If the link can be bundled into a link already in the cloud
+  if (CloudGraphAddToBundle(cloud, from, to, 1))
+    // Nothing else to do
+    return 0;
+  // Create the link in the arena
+  CloudGraphLink *link = CloudGraphArenaCreateLink(cloud);
+  if (link == NULL)
+    return 2;
+  link->_nodes[0] = from;
+  link->_nodes[1] = to;
+  // Add the link itself to the cloud, the arguments being valid it can
+  // only fail on memory allocation
+  if (CloudGraphAppendLink(cloud, link) == false) {
+    CloudGraphReleaseLink(cloud, &link);
+    return 2;
+  }
+  // Return the success code
+  return 0;
+}
+
+// If 'cloud' bundles its links and has a link between the nodes 
+// 'from' and 'to', in any direction, add 'weight' to the weight of 
+// this link, the weight saturates at INT_MAX
+// Return true if 'weight' was added to a link, else return false
+bool CloudGraphAddToBundle(CloudGraph *cloud, int from, int to, 
+  int weight) {
+  // If the links are not bundled or there is no link yet
+  if (cloud->_bundleLinks == false || cloud->_linkSet._nb == 0)
+    return false;
+  // Search the link between the two nodes
+  CloudGraphLink *bundle = cloud->_linkSet._slots[
+    CloudGraphLinkSetSlot(&(cloud->_linkSet), from, to)];
+  if (bundle == NULL)
+    return false;
+  // Add the weight
+  if (bundle->_weight > INT_MAX - weight)
+    bundle->_weight = INT_MAX;
+  else
+    bundle->_weight += weight;
+  CloudGraphInvalidateViews(cloud);
+  return true;
+}
+
+// Return the position of the slot of the set of links 'set' holding 
+// the link between the nodes 'from' and 'to', in any direction, or of
+// the empty slot where it would be inserted
+// The capacity of 'set' must not be 0
+int CloudGraphLinkSetSlot(const CloudGraphLinkSet *set, int from, 
+  int to) {
+  // Hash the pair of nodes in increasing order, the multiplication 
+  // spreads the bits of the pair into the high bits of the hash
+  int mask = set->_capacity - 1;
+  int slot = CloudGraphLinkSetHome(set, from, to);
+  // Probe the slots until the link or an empty slot
+  while (set->_slots[slot] != NULL) {
+    CloudGraphLink *link = set->_slots[slot];
+    if ((link->_nodes[0] == from && link->_nodes[1] == to) ||
+      (link->_nodes[0] == to && link->_nodes[1] == from))
+      break;
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+// Return the position of the first slot probed in the set of links 
+// 'set' for the link between the nodes 'from' and 'to'
+int CloudGraphLinkSetHome(const CloudGraphLinkSet *set, int from, 
+  int to) {
+  // Hash the pair of nodes in increasing order, the multiplication 
+  // spreads the bits of the pair into the high bits of the hash
+  uint64_t key = ((uint64_t)(uint32_t)(from < to ? from : to) << 32) |
+    (uint64_t)(uint32_t)(from < to ? to : from);
+  uint64_t hash = key * CLOUDGRAPH_LINKSETHASH;
+  return (int)(hash >> 33) & (set->_capacity - 1);
+}
+
+// Remove the link 'link' from the set of links 'set'
+// The following links of the same probe sequence are moved back into
+// the emptied slot when it is on their sequence, so that no search 
+// stops before them
+// Do nothing if 'link' is not in 'set'
+void CloudGraphLinkSetRemove(CloudGraphLinkSet *set, 
+  CloudGraphLink *link) {
+  // If the link is not in the set
+  if (set->_nb == 0)
+    return;
+  int hole = CloudGraphLinkSetSlot(set, link->_nodes[0], 
+    link->_nodes[1]);
+  if (set->_slots[hole] != link)
+    return;
+  // Empty the slot
+  set->_slots[hole] = NULL;
+  --(set->_nb);
+  // Loop on the following links up to the next empty slot
+  int mask = set->_capacity - 1;
+  for (int iSlot = (hole + 1) & mask; set->_slots[iSlot] != NULL; 
+    iSlot = (iSlot + 1) & mask) {
+    CloudGraphLink *next = set->_slots[iSlot];
+    int home = CloudGraphLinkSetHome(set, next->_nodes[0], 
+      next->_nodes[1]);
+    // If the hole is between the first slot probed for this link and
+    // its slot, move the link into the hole
+    if (((iSlot - home) & mask) >= ((iSlot - hole) & mask)) {
+      set->_slots[hole] = next;
+      set->_slots[iSlot] = NULL;
+      hole = iSlot;
+    }
+  }
+}
+
+// Ensure the set of links 'set' can hold 'nb' links
+// The set is kept at most half full, when it grows the links are 
+// inserted again in the new slots
+// Return false if memory allocation failed, else return true
+bool CloudGraphLinkSetReserve(CloudGraphLinkSet *set, int nb) {
+  // If the set is large enough
+  if (nb <= set->_capacity / 2)
+    return true;
+  // Calculate the new capacity
+  if (nb > INT_MAX / 4)
+    return false;
+  int capacity = (set->_capacity > 0 ? set->_capacity : 
+    CLOUDGRAPH_LINKSETMINCAPACITY);
+  while (nb > capacity / 2)
+    capacity *= 2;
+  // Allocate the new slots
+  CloudGraphLinkSet grown;
+  grown._nb = 0;
+  grown._capacity = capacity;
+  grown._slots = 
+    (CloudGraphLink**)calloc((size_t)capacity, sizeof(CloudGraphLink*));
+  if (grown._slots == NULL)
+    return false;
+  // Insert the links in the new slots
+  for (int iSlot = 0; iSlot < set->_capacity; ++iSlot)
+    if (set->_slots[iSlot] != NULL)
+      CloudGraphLinkSetInsert(&grown, set->_slots[iSlot]);
+  // Replace the slots
+  CloudGraphLinkSetFree(set);
+  *set = grown;
+  return true;
+}
+
+// Insert the link 'link' in the set of links 'set', which must have 
+// been reserved for it and not contain a link between the same nodes
+void CloudGraphLinkSetInsert(CloudGraphLinkSet *set, 
+  CloudGraphLink *link) {
+  set->_slots[CloudGraphLinkSetSlot(set, link->_nodes[0], 
+    link->_nodes[1])] = link;
+  ++(set->_nb);
+}
+
+// Free the memory used by the set of links 'set'
+void CloudGraphLinkSetFree(CloudGraphLinkSet *set) {
+  if (set->_slots != NULL)
+    free(set->_slots);
+  memset(set, 0, sizeof(CloudGraphLinkSet));
+}
+
+// Get in 'width' and 'height' the size of the bounding box of 'label'
+// (an empty label if NULL) with the font of 'cloud' at 'size', before
+// rotation, from the cache of label metrics of 'cloud', measuring it 
+// if it is not in the cache yet
+// Return false if memory allocation failed, else return true
+bool CloudGraphGetLabelMetric(CloudGraph *cloud, const char *label, 
+  float size, float *width, float *height) {
+  CloudGraphLabelCache *cache = &(cloud->_labelCache);
+  if (label == NULL)
+    label = "";
+  // Hash the label and the size
+  uint64_t hash = CloudGraphHashBytes(CLOUDGRAPH_FNVOFFSET, label, 
+    strlen(label));
+  hash = CloudGraphHashBytes(hash, &size, sizeof(float));
+  // If the metrics are in the cache, return them
+  if (cache->_capacity > 0) {
+    CloudGraphLabelMetric *metric = 
+      cache->_slots + CloudGraphLabelCacheSlot(cache, label, size, hash);
+    if (metric->_label != NULL) {
+      *width = metric->_width;
+      *height = metric->_height;
+      return true;
+    }
+  }
+  // Measure the label without rotation
+  VecFloat *right = VecFloatCreate(2);
+  if (right == NULL)
+    return false;
+  VecSet(right, 0, 1.0);
+  VecSet(right, 1, 0.0);
+  TGAFontSetSize(cloud->_font, size);
+  TGAFontSetRight(cloud->_font, right);
+  VecFree(&right);
+  Shapoid *bound = TGAFontGetStringBound(cloud->_font, 
+    (unsigned char*)label);
+  if (bound == NULL)
+    return false;
+  *width = VecNorm(bound->_axis[0]);
+  *height = VecNorm(bound->_axis[1]);
+  ShapoidFree(&bound);
+  // Add the metrics to the cache, with a copy of the label as 'label'
+  // may be freed with its node while the cache lives
+  if (CloudGraphLabelCacheReserve(cache, cache->_nb + 1) == false)
+    return false;
+  char *copy = CloudGraphArenaCopyString(cloud, label);
+  if (copy == NULL)
+    return false;
+  CloudGraphLabelMetric *metric = 
+    cache->_slots + CloudGraphLabelCacheSlot(cache, label, size, hash);
+  metric->_label = copy;
+  metric->_hash = hash;
+  metric->_size = size;
+  metric->_width = *width;
+  metric->_height = *height;
+  ++(cache->_nb);
+  return true;
+}
+
+// Get in 'width' and 'height' the size of the bounding box of the 
+// label of 'node' at 'size' as CloudGraphGetLabelMetric, from the size
+// memorized in 'node' if it was measured at 'size', else memorize it
+// Return false if memory allocation failed, else return true
+bool CloudGraphGetNodeLabelMetric(CloudGraph *cloud, 
+  CloudGraphNode *node, float size, float *width, float *height) {
+  // If the label has not been measured at this size
+  if (node->_labelSize != size) {
+    // Get its size from the cache of label metrics
+    if (CloudGraphGetLabelMetric(cloud, node->_label, size, 
+      &(node->_labelWidth), &(node->_labelHeight)) == false)
+      return false;
+    node->_labelSize = size;
+  }
+  // Return the memorized size
+  *width = node->_labelWidth;
+  *height = node->_labelHeight;
+  return true;
+}
+
+// Return the position of the slot of the cache of label metrics 
+// 'cache' holding the metrics of 'label' at 'size', whose hash is 
+// 'hash', or of the empty slot where they would be inserted
+// The capacity of 'cache' must not be 0
+int CloudGraphLabelCacheSlot(const CloudGraphLabelCache *cache, 
+  const char *label, float size, uint64_t hash) {
+  int mask = cache->_capacity - 1;
+  int slot = (int)(hash & (uint64_t)mask);
+  // Probe the slots until the metrics or an empty slot
+  while (cache->_slots[slot]._label != NULL) {
+    CloudGraphLabelMetric *metric = cache->_slots + slot;
+    if (metric->_hash == hash && metric->_size == size &&
+      strcmp(metric->_label, label) == 0)
+      break;
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+// Ensure the cache of label metrics 'cache' can hold 'nb' metrics
+// The cache is kept at most half full, when it grows the metrics are 
+// inserted again in the new slots
+// Return false if memory allocation failed, else return true
+bool CloudGraphLabelCacheReserve(CloudGraphLabelCache *cache, int nb) {
+  // If the cache is large enough
+  if (nb <= cache->_capacity / 2)
+    return true;
+  // Calculate the new capacity
+  if (nb > INT_MAX / 4)
+    return false;
+  int capacity = (cache->_capacity > 0 ? cache->_capacity : 
+    CLOUDGRAPH_LINKSETMINCAPACITY);
+  while (nb > capacity / 2)
+    capacity *= 2;
+  // Allocate the new slots
+  CloudGraphLabelCache grown;
+  grown._nb = cache->_nb;
+  grown._capacity = capacity;
+  grown._slots = (CloudGraphLabelMetric*)calloc((size_t)capacity, 
+    sizeof(CloudGraphLabelMetric));
+  if (grown._slots == NULL)
+    return false;
+  // Insert the metrics in the new slots
+  for (int iSlot = 0; iSlot < cache->_capacity; ++iSlot) {
+    CloudGraphLabelMetric *metric = cache->_slots + iSlot;
+    if (metric->_label != NULL)
+      grown._slots[CloudGraphLabelCacheSlot(&grown, metric->_label, 
+        metric->_size, metric->_hash)] = *metric;
+  }
+  // Replace the slots
+  CloudGraphLabelCacheFree(cache);
+  *cache = grown;
+  return true;
+}
+
+// Free the memory used by the cache of label metrics 'cache'
+void CloudGraphLabelCacheFree(CloudGraphLabelCache *cache) {
+  if (cache->_slots != NULL)
+    free(cache->_slots);
+  memset(cache, 0, sizeof(CloudGraphLabelCache));
+}
+
+// Set the bounding box of a label 'bound' to 'width' and 'height' 
+// rotated to the right direction 'right' (2 floats)
+// The first axis is along 'right' and the second one is 'right' 
+// rotated by a quarter turn counter-clockwise, as the bounding boxes 
+// of TGAFontGetStringBound
+// Its position is left unchanged
+void CloudGraphSetLabelBound(CloudGraphBox *bound, float width, 
+  float height, const float *right) {
+  // Get the unit right direction
+  float rx = right[0];
+  float ry = right[1];
+  float norm = sqrtf(rx * rx + ry * ry);
+  if (norm > 0.0) {
+    rx /= norm;
+    ry /= norm;
+  } else {
+    rx = 1.0;
+    ry = 0.0;
+  }
+  // Set the axis
+  bound->_axis[0][0] = rx * width;
+  bound->_axis[0][1] = ry * width;
+  bound->_axis[1][0] = -ry * height;
+  bound->_axis[1][1] = rx * height;
+}
+
+// Load the CloudGraph from 'stream'
+// If 'cloud' is not NULL it is first freed
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: invalid data
+// 4: fscanf error
+int CloudGraphLoad(CloudGraph **cloud, FILE *stream) {
+  // Check arguments
+  if (*cloud == NULL || stream == NULL)
+    return 1;
+  // Memorize the mode of the links of the cloud
+  bool lazyLinks = (*cloud)->_lazyLinks;
+  bool bundleLinks = (*cloud)->_bundleLinks;
+  // If cloud already exists
+  if (*cloud != NULL)
+    // Free it
+    CloudGraphFree(cloud);
+  // Create the cloud
+  *cloud = CloudGraphCreate();
+  // If we couldn't allocate memory
+  if (*cloud == NULL)
+    return 2;
+  (*cloud)->_lazyLinks = lazyLinks;
+  (*cloud)->_bundleLinks = bundleLinks;
+  // Declare a buffer to read the family and node labels, they are 
+  // copied in the arena with their proper length
+  char label[CLOUDGRAPH_MAXLENGTHLABEL] = {'\0'};
+  // Declare a variable to read the rgb
+  int rgb[3] = {0};
+  // Read the number of families
+  int nbFamily = 0;
+  int ret = fscanf(stream, "%d", &nbFamily);
+  // If the fscanf failed
+  if (ret == EOF) {
+    // Free memory and stop here
+    CloudGraphFree(cloud);
+    return 4;
+  }
+  // If the number of family is invalid
+  if (nbFamily <= 0) {
+    // Free memory and stop here
+    CloudGraphFree(cloud);
+    return 3;
+  }
+  // For each family
+  for (int iFamily = nbFamily; iFamily--;) {
+    // Read the family properties
+    int id = 0;
+    ret = fscanf(stream, "%d %d %d %d ", &id, rgb, rgb + 1, rgb + 2);
+    // Check values
+    if (ret == EOF || id < 0 || id >= nbFamily ||
+      rgb[0] < 0 || rgb[0] > 255 || rgb[1] < 0 || rgb[1] > 255 || 
+      rgb[2] < 0 || rgb[2] > 255 ||
+      fgets(label, CLOUDGRAPH_MAXLENGTHLABEL, stream) == NULL) {
+      // Free memory and stop here
+      CloudGraphFree(cloud);
+      return 3;
+    }
+    // Remove the line return
+    label[strlen(label) - 1] = '\0';
+    // Create the family in the arena
+    CloudGraphFamily *family = CloudGraphArenaCreateFamily(*cloud);
+    if (family != NULL)
+      family->_label = CloudGraphArenaCopyString(*cloud, label);
+    if (family == NULL || family->_label == NULL) {
+      // Free memory and stop here
+      CloudGraphReleaseFamily(*cloud, &family);
+      CloudGraphFree(cloud);
+      return 2;
+    }
+    family->_id = id;
+    // Convert rgb values
+    for (int iRgb = 3; iRgb--;)
+      family->_rgba[iRgb] = rgb[iRgb];
+    // Add the family itself to the cloud
+    if (CloudGraphAppendFamily(*cloud, family) == false) {
+      // Free memory and stop here
+      CloudGraphReleaseFamily(*cloud, &family);
+      CloudGraphFree(cloud);
+      return 3;
+    }
+  }
+  // Read the number of nodes
+  int nbNode = 0;
+  ret = fscanf(stream, "%d", &nbNode);
+  // If the fscanf failed
+  if (ret == EOF) {
+    // Free memory and stop here
+    CloudGraphFree(cloud);
+    return 4;
+  }
+  // If the number of node is invalid
+  if (nbNode <= 0) {
+    // Free memory and stop here
+    CloudGraphFree(cloud);
+    return 3;
+  }
+  // Reserve the index of nodes at once
+  if (CloudGraphReserveNodeIndex(*cloud, nbNode - 1) == false) {
+    // Free memory and stop here
+    CloudGraphFree(cloud);
+    return 2;
+  }
+  // For each node
+  for (int iNode = nbNode; iNode--;) {
+    // Read the node properties
+    int id = 0;
+    int idFamily = 0;
+    ret = fscanf(stream, "%d %d ", &id, &idFamily);
+    // Check values
+    if (ret == EOF || id < 0 || id >= nbNode ||
+      idFamily < 0 || idFamily >= nbFamily ||
+      fgets(label, CLOUDGRAPH_MAXLENGTHLABEL, stream) == NULL) {
+      // Free memory and stop here
+      CloudGraphFree(cloud);
+      return 3;
+    }
+    // Remove the line return
+    label[strlen(label) - 1] = '\0';
+    // Create the node in the arena
+    CloudGraphNode *node = CloudGraphArenaCreateNode(*cloud);
+    if (node != NULL)
+      node->_label = CloudGraphArenaCopyString(*cloud, label);
+    if (node == NULL || node->_label == NULL) {
+      // Free memory and stop here
+      CloudGraphReleaseNode(*cloud, &node);
+      CloudGraphFree(cloud);
+      return 2;
+    }
+    node->_id = id;
+    node->_family = idFamily;
+    // Add the node itself to the cloud
+    if (CloudGraphAppendNode(*cloud, node) == false) {
+      // Free memory and stop here
+      CloudGraphReleaseNode(*cloud, &node);
+      CloudGraphFree(cloud);
+      return 3;
     }
   }
   // Read the number of link
@@ -686,166 +2878,1155 @@ int CloudGraphLoad(CloudGraph **cloud, FILE *stream) {
   if (ret == EOF) {
     // Free memory and stop here
     CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
     return 4;
   }
   // If the number of link is invalid
   if (nbLink < 0) {
     // Free memory and stop here
     CloudGraphFree(cloud);
-    CloudGraphFamilyFree(&family);
-    CloudGraphNodeFree(&node);
-    CloudGraphLinkFree(&link);
     return 3;
   }
   // For each node
   for (int iLink = nbLink; iLink--;) {
     // Read the link properties
-    ret = fscanf(stream, "%d %d", link->_nodes, link->_nodes + 1);
+    int nodes[2] = {-1, -1};
+    ret = fscanf(stream, "%d %d", nodes, nodes + 1);
     // Check values
-    if (link->_nodes[0] < 0 || link->_nodes[0] >= nbNode ||
-      link->_nodes[1] < 0 || link->_nodes[1] >= nbNode) {
+    if (nodes[0] < 0 || nodes[0] >= nbNode ||
+      nodes[1] < 0 || nodes[1] >= nbNode) {
       // Free memory and stop here
       CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
       return 3;
     }
-    if (CloudGraphAddLink(*cloud, link) == false) {
+    // Add the link to the cloud
+    ret = CloudGraphAddLinkNodes(*cloud, nodes[0], nodes[1]);
+    if (ret != 0) {
       // Free memory and stop here
       CloudGraphFree(cloud);
-      CloudGraphFamilyFree(&family);
-      CloudGraphNodeFree(&node);
-      CloudGraphLinkFree(&link);
-      return 3;
+      return ret;
     }
   }
-  // Free memory
-  CloudGraphFamilyFree(&family);
-  CloudGraphNodeFree(&node);
-  CloudGraphLinkFree(&link);
   // Return the success code
   return 0;
 }
 
-// Sort the masses in the GSet of the SpringSys in order of their
-// families 
-// Do nothing if arguments are invalid
-void CloudGraphSortNodeByFamily(CloudGraph *cloud) {
+// Load the CloudGraph from the file 'path' in the same text format as
+// CloudGraphLoad
+// The file is memory mapped and parsed in place, labels of nodes and 
+// families point into the mapping which is owned by the CloudGraph 
+// and released by CloudGraphFree
+// If 'cloud' is not NULL it is first freed
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: invalid data
+// 4: can't open or map the file, or unexpected end of file
+int CloudGraphLoadFile(CloudGraph **cloud, const char *path) {
+  // Load the file with a single thread
+  return CloudGraphLoadFileParallel(cloud, path, 1);
+}
+
+// Load the CloudGraph from the file 'path' as CloudGraphLoadFile, and
+// parse the links section with 'nbThread' threads
+// The links section is split into chunks aligned on line returns, so 
+// each link must be on its own line
+// Return the same codes as CloudGraphLoadFile
+int CloudGraphLoadFileParallel(CloudGraph **cloud, const char *path, 
+  int nbThread) {
   // Check arguments
-  if (cloud == NULL)
-    return;
-  // Declare a pointer to the first element of the GSet of nodes
-  GSetElem *elem = cloud->_nodes->_head;
-  // Loop over the masses
-  while (elem != NULL) {
-    // Set the sort value of this element to the family index of its
-    // node
-    CloudGraphNode *node = (CloudGraphNode*)(elem->_data);
-    elem->_sortVal = (float)(node->_family);
-    // Move the pointer to the next mass
-    elem = elem->_next;
+  if (cloud == NULL || path == NULL || nbThread < 1)
+    return 1;
+  // Memorize the mode of the links of the cloud
+  bool lazyLinks = (*cloud != NULL && (*cloud)->_lazyLinks);
+  bool bundleLinks = (*cloud != NULL && (*cloud)->_bundleLinks);
+  // If cloud already exists
+  if (*cloud != NULL)
+    // Free it
+    CloudGraphFree(cloud);
+  // Open the file
+  int fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return 4;
+  // Get the size of the file
+  struct stat st;
+  if (fstat(fd, &st) == -1 || st.st_size <= 0) {
+    close(fd);
+    return 4;
+  }
+  // Map the file
+  // The mapping is private and writable to be able to terminate the 
+  // labels in place, only the pages containing labels get copied
+  size_t size = (size_t)(st.st_size);
+  char *map = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, 
+    MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after closing the file
+  close(fd);
+  if (map == MAP_FAILED)
+    return 4;
+  // The data is read sequentially
+  madvise(map, size, MADV_SEQUENTIAL);
+  // Create the cloud
+  *cloud = CloudGraphCreate();
+  if (*cloud == NULL) {
+    munmap(map, size);
+    return 2;
   }
-  // Sort the GSet of masses
-  GSetSort(cloud->_nodes);
+  (*cloud)->_lazyLinks = lazyLinks;
+  (*cloud)->_bundleLinks = bundleLinks;
+  // Give the mapping to the cloud, it will be released with it
+  (*cloud)->_map = map;
+  (*cloud)->_mapSize = size;
+  // Parse the data
+  int ret = CloudGraphLoadMapped(*cloud, map, map + size, nbThread);
+  // If the data couldn't be parsed
+  if (ret != 0)
+    // Free memory
+    CloudGraphFree(cloud);
+  // Return the result code
+  return ret;
 }
 
-// Arrange the position of the nodes of the graph in line
-// Return true if it could arrange nodes
-// Return false if arguments are invalid or it couldn't arrange nodes
-bool CloudGraphArrangeLine(CloudGraph *cloud, CloudGraphOpt *opt) {
+// Load the CloudGraph 'cloud' from the data between 'ptr' and 'end'
+// in the text format of CloudGraphLoad
+// Labels are not copied: the line return after each label is replaced
+// with '\0' and the label points into the data
+// The links are parsed with 'nbThread' threads
+// Return the same codes as CloudGraphLoad
+int CloudGraphLoadMapped(CloudGraph *cloud, char *ptr, char *end, 
+  int nbThread) {
   // Check arguments
-  if (cloud == NULL || opt == NULL)
-    return false;
-  // Declare a variable to calculate the position of families label
-  float *posFamily = 
-    (float*)malloc(sizeof(float) * cloud->_families->_nbElem);
-  int *nbFamily = 
-    (int*)malloc(sizeof(int) * cloud->_families->_nbElem);
-  // If we couldn't allocate memory
-  if (posFamily == NULL || nbFamily == NULL) {
-    if (posFamily != NULL) free(posFamily);
-    if (nbFamily != NULL) free(nbFamily);
-    // Stop here
-    return false;
-  }
-  for (int iFamily = cloud->_families->_nbElem; iFamily--;) {
-    posFamily[iFamily] = 0.0;
-    nbFamily[iFamily] = 0;
+  if (cloud == NULL || ptr == NULL || end == NULL)
+    return 1;
+  // Read the number of families
+  int nbFamily = 0;
+  if (CloudGraphScanInt(&ptr, end, &nbFamily) == false)
+    return (ptr >= end ? 4 : 3);
+  // If the number of family is invalid
+  if (nbFamily <= 0)
+    return 3;
+  // For each family
+  for (int iFamily = nbFamily; iFamily--;) {
+    // Read the family properties
+    int id = 0;
+    int rgb[3] = {0};
+    if (CloudGraphScanInt(&ptr, end, &id) == false ||
+      CloudGraphScanInt(&ptr, end, rgb) == false ||
+      CloudGraphScanInt(&ptr, end, rgb + 1) == false ||
+      CloudGraphScanInt(&ptr, end, rgb + 2) == false)
+      return 3;
+    // Check values
+    if (id < 0 || id >= nbFamily ||
+      rgb[0] < 0 || rgb[0] > 255 || rgb[1] < 0 || rgb[1] > 255 || 
+      rgb[2] < 0 || rgb[2] > 255)
+      return 3;
+    // Read the label
+    char *label = NULL;
+    if (CloudGraphScanLabel(cloud, &ptr, end, &label) == false)
+      return (label == NULL ? 3 : 2);
+    // Create the family in the arena, the label is in the memory 
+    // mapping or the arena
+    CloudGraphFamily *family = CloudGraphArenaCreateFamily(cloud);
+    if (family == NULL)
+      return 2;
+    family->_id = id;
+    for (int iRgb = 3; iRgb--;)
+      family->_rgba[iRgb] = rgb[iRgb];
+    family->_label = label;
+    // Add the family itself to the cloud
+    if (CloudGraphAppendFamily(cloud, family) == false) {
+      CloudGraphReleaseFamily(cloud, &family);
+      return 3;
+    }
   }
-  // Declare a pointer toward the nodes
-  GSetElem *ptr = cloud->_nodes->_head;
-  // Declare a variable to memorize the index of the node in the set
-  int iNode = 0;
-  // Loop on the nodes
-  while (ptr != NULL) {
-    // Declare a pointer to the node
-    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
-    // Set the position of the node
-    VecSet(node->_pos, 0, 0.0);
-    VecSet(node->_pos, 1, 
-      2.0 * opt->_fontSizeNode * ((float)iNode + 0.5));
-    // Calculate the family position
-    posFamily[node->_family] += VecGet(node->_pos, 1);
-    ++(nbFamily[node->_family]);
-    // Set the right of the node
-    VecSet(node->_right, 0, 1.0);
-    VecSet(node->_right, 1, 0.0);
-    // Set the angle with abciss
-    node->_theta = 0.0;
-    // Continue with the next node
+  // Read the number of nodes
+  int nbNode = 0;
+  if (CloudGraphScanInt(&ptr, end, &nbNode) == false)
+    return (ptr >= end ? 4 : 3);
+  // If the number of node is invalid
+  if (nbNode <= 0)
+    return 3;
+  // Reserve the index of nodes at once
+  if (CloudGraphReserveNodeIndex(cloud, nbNode - 1) == false)
+    return 2;
+  // For each node
+  for (int iNode = nbNode; iNode--;) {
+    // Read the node properties
+    int id = 0;
+    int idFamily = 0;
+    if (CloudGraphScanInt(&ptr, end, &id) == false ||
+      CloudGraphScanInt(&ptr, end, &idFamily) == false)
+      return 3;
+    // Check values
+    if (id < 0 || id >= nbNode || idFamily < 0 || idFamily >= nbFamily)
+      return 3;
+    // Read the label
+    char *label = NULL;
+    if (CloudGraphScanLabel(cloud, &ptr, end, &label) == false)
+      return (label == NULL ? 3 : 2);
+    // Create the node in the arena, the label is in the memory 
+    // mapping or the arena
+    CloudGraphNode *node = CloudGraphArenaCreateNode(cloud);
+    if (node == NULL)
+      return 2;
+    node->_id = id;
+    node->_family = idFamily;
+    node->_label = label;
+    // Add the node itself to the cloud
+    if (CloudGraphAppendNode(cloud, node) == false) {
+      CloudGraphReleaseNode(cloud, &node);
+      return 3;
+    }
+  }
+  // Read the number of links
+  int nbLink = 0;
+  if (CloudGraphScanInt(&ptr, end, &nbLink) == false)
+    return (ptr >= end ? 4 : 3);
+  // If the number of link is invalid
+  if (nbLink < 0)
+    return 3;
+  // If there are enough links to share them among threads
+  if (nbThread > 1 && nbLink >= CLOUDGRAPH_MINLINKPERTHREAD * nbThread)
+    // Parse the links in parallel
+    return CloudGraphLoadLinksParallel(cloud, ptr, end, nbNode, nbLink,
+      nbThread);
+  // For each link
+  for (int iLink = nbLink; iLink--;) {
+    // Read the link properties
+    int nodes[2] = {-1, -1};
+    if (CloudGraphScanInt(&ptr, end, nodes) == false ||
+      CloudGraphScanInt(&ptr, end, nodes + 1) == false)
+      return 3;
+    // Check values
+    if (nodes[0] < 0 || nodes[0] >= nbNode ||
+      nodes[1] < 0 || nodes[1] >= nbNode)
+      return 3;
+    // Add the link to the cloud
+    int ret = CloudGraphAddLinkNodes(cloud, nodes[0], nodes[1]);
+    if (ret != 0)
+      return ret;
+  }
+  // Return the success code
+  return 0;
+}
+
+// Load the 'nbLink' links of the CloudGraph 'cloud' from the data 
+// between 'ptr' and 'end' using 'nbThread' threads
+// The data is split into chunks aligned on line returns, each chunk is
+// parsed by one thread into its own array of pairs, and the arrays are
+// checked, then added in the order of the chunks, once all threads 
+// are done
+// Links are expected to be one per line, node IDs must be in 
+// [0, 'nbNode'[
+// Return the same codes as CloudGraphLoad
+int CloudGraphLoadLinksParallel(CloudGraph *cloud, char *ptr, char *end,
+  int nbNode, int nbLink, int nbThread) {
+  // Check arguments
+  if (cloud == NULL || ptr == NULL || end == NULL || nbThread < 1)
+    return 1;
+  // Allocate memory for the chunks and the threads
+  CloudGraphLinkChunk *chunks = 
+    (CloudGraphLinkChunk*)malloc(sizeof(CloudGraphLinkChunk) * nbThread);
+  pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * nbThread);
+  bool *started = (bool*)malloc(sizeof(bool) * nbThread);
+  if (chunks == NULL || threads == NULL || started == NULL) {
+    if (chunks != NULL) free(chunks);
+    if (threads != NULL) free(threads);
+    if (started != NULL) free(started);
+    return 2;
+  }
+  // Split the data into chunks, each chunk but the last one ends after
+  // a line return
+  size_t length = end - ptr;
+  char *start = ptr;
+  for (int iThread = 0; iThread < nbThread; ++iThread) {
+    char *stop = end;
+    if (iThread < nbThread - 1) {
+      stop = ptr + length / nbThread * (iThread + 1);
+      if (stop < start)
+        stop = start;
+      char *eol = (char*)memchr(stop, '\n', end - stop);
+      stop = (eol == NULL ? end : eol + 1);
+    }
+    chunks[iThread]._start = start;
+    chunks[iThread]._end = stop;
+    chunks[iThread]._nbNode = nbNode;
+    chunks[iThread]._pairs = NULL;
+    chunks[iThread]._nbPair = 0;
+    chunks[iThread]._failed = false;
+    chunks[iThread]._noMem = false;
+    start = stop;
+  }
+  // Parse the chunks, in the calling thread if a thread can't be 
+  // started
+  for (int iThread = 0; iThread < nbThread; ++iThread) {
+    started[iThread] = (pthread_create(threads + iThread, NULL, 
+      CloudGraphParseLinkChunk, chunks + iThread) == 0);
+    if (started[iThread] == false)
+      CloudGraphParseLinkChunk(chunks + iThread);
+  }
+  for (int iThread = 0; iThread < nbThread; ++iThread)
+    if (started[iThread])
+      pthread_join(threads[iThread], NULL);
+  // Count the pairs in the order of the chunks until all the links 
+  // are found
+  int ret = 0;
+  int nbFound = 0;
+  for (int iThread = 0; iThread < nbThread && ret == 0 && 
+    nbFound < nbLink; ++iThread) {
+    CloudGraphLinkChunk *chunk = chunks + iThread;
+    nbFound += (chunk->_nbPair < nbLink - nbFound ? chunk->_nbPair : 
+      nbLink - nbFound);
+    // If the parsing of this chunk stopped before its end while links
+    // are still missing
+    if (nbFound < nbLink && chunk->_noMem)
+      ret = 2;
+    else if (nbFound < nbLink && chunk->_failed)
+      ret = 3;
+  }
+  // If links are missing
+  if (ret == 0 && nbFound < nbLink)
+    ret = 3;
+  // Add the links in the order of the chunks, created in the arena, 
+  // the node IDs are in [0, 'nbNode'[ but the nodes may not exist, as
+  // in CloudGraphLoad
+  int nbAdded = 0;
+  for (int iThread = 0; iThread < nbThread && ret == 0 && 
+    nbAdded < nbLink; ++iThread) {
+    CloudGraphLinkChunk *chunk = chunks + iThread;
+    for (int iPair = 0; iPair < chunk->_nbPair && ret == 0 && 
+      nbAdded < nbLink; ++iPair) {
+      ret = CloudGraphAddLinkNodes(cloud, chunk->_pairs[2 * iPair], 
+        chunk->_pairs[2 * iPair + 1]);
+      if (ret == 0)
+        ++nbAdded;
+    }
+  }
+  // Free memory
+  for (int iThread = 0; iThread < nbThread; ++iThread)
+    if (chunks[iThread]._pairs != NULL)
+      free(chunks[iThread]._pairs);
+  free(chunks);
+  free(threads);
+  free(started);
+  // Return the result code
+  return ret;
+}
+
+// Parse the pairs of node IDs of links in the chunk 'arg' (a 
+// CloudGraphLinkChunk) until the end of the chunk or invalid data
+// Thread function of CloudGraphLoadLinksParallel
+// Return NULL
+void* CloudGraphParseLinkChunk(void *arg) {
+  CloudGraphLinkChunk *chunk = (CloudGraphLinkChunk*)arg;
+  // Estimate the number of pairs from the length of the chunk, the 
+  // shortest line "0 1\n" is 4 characters
+  int capacity = (int)((chunk->_end - chunk->_start) / 8) + 16;
+  chunk->_pairs = (int*)malloc(sizeof(int) * 2 * capacity);
+  if (chunk->_pairs == NULL) {
+    chunk->_noMem = true;
+    return NULL;
+  }
+  char *ptr = chunk->_start;
+  int pair[2];
+  // Loop until the end of the chunk
+  while (ptr < chunk->_end) {
+    // Read the pair
+    if (CloudGraphScanInt(&ptr, chunk->_end, pair) == false) {
+      // If there is only white spaces up to the end of the chunk
+      if (ptr >= chunk->_end)
+        break;
+      chunk->_failed = true;
+      break;
+    }
+    if (CloudGraphScanInt(&ptr, chunk->_end, pair + 1) == false ||
+      pair[0] < 0 || pair[0] >= chunk->_nbNode ||
+      pair[1] < 0 || pair[1] >= chunk->_nbNode) {
+      chunk->_failed = true;
+      break;
+    }
+    // Grow the array if needed
+    if (chunk->_nbPair == capacity) {
+      capacity *= 2;
+      int *pairs = (int*)realloc(chunk->_pairs, 
+        sizeof(int) * 2 * capacity);
+      if (pairs == NULL) {
+        chunk->_noMem = true;
+        break;
+      }
+      chunk->_pairs = pairs;
+    }
+    // Memorize the pair
+    chunk->_pairs[2 * chunk->_nbPair] = pair[0];
+    chunk->_pairs[2 * chunk->_nbPair + 1] = pair[1];
+    ++(chunk->_nbPair);
+  }
+  return NULL;
+}
+
+// Skip the white spaces and read an integer in the data between '*ptr' 
+// and 'end' into 'val', and move '*ptr' after the integer
+// Return false if there is no integer at '*ptr', else return true
+bool CloudGraphScanInt(char **ptr, char *end, int *val) {
+  // Declare a pointer to the current character
+  char *c = *ptr;
+  // Skip the white spaces
+  while (c < end && (*c == ' ' || *c == '\n' || *c == '\t' || 
+    *c == '\r' || *c == '\v' || *c == '\f'))
+    ++c;
+  // Read the sign if any
+  bool neg = false;
+  if (c < end && (*c == '-' || *c == '+')) {
+    neg = (*c == '-');
+    ++c;
+  }
+  // If there is no digit
+  if (c >= end || *c < '0' || *c > '9') {
+    // Leave the pointer after the white spaces and stop here
+    *ptr = c;
+    return false;
+  }
+  // Read the digits
+  long v = 0;
+  while (c < end && *c >= '0' && *c <= '9') {
+    if (v <= INT_MAX)
+      v = v * 10 + (*c - '0');
+    ++c;
+  }
+  // Clip to the range of int
+  if (v > INT_MAX)
+    v = INT_MAX;
+  *val = (int)(neg ? -v : v);
+  // Move the pointer after the integer
+  *ptr = c;
+  // Return the success code
+  return true;
+}
+
+// Skip the white spaces and get the label up to the end of the line in
+// the data between '*ptr' and 'end' of the memory mapping of 'cloud' 
+// into 'label', and move '*ptr' to the next line
+// The line return is replaced with '\0' and the label points into the 
+// mapping, except for a label at the very end of the data which can't 
+// be terminated in place and is copied in the arena
+// Return false if the label is empty ('*label' is NULL) or memory 
+// allocation failed ('*label' is not NULL), else return true
+bool CloudGraphScanLabel(CloudGraph *cloud, char **ptr, char *end, 
+  char **label) {
+  // Declare a pointer to the current character
+  char *c = *ptr;
+  // Skip the white spaces, as the space at the end of the format of 
+  // fscanf in CloudGraphLoad
+  while (c < end && (*c == ' ' || *c == '\n' || *c == '\t' || 
+    *c == '\r' || *c == '\v' || *c == '\f'))
+    ++c;
+  // If the label is empty
+  if (c >= end) {
+    *ptr = c;
+    *label = NULL;
+    return false;
+  }
+  // Search the end of the line
+  char *eol = (char*)memchr(c, '\n', end - c);
+  // If there is a line return
+  if (eol != NULL) {
+    // Terminate the label in place
+    *eol = '\0';
+    *label = c;
+    *ptr = eol + 1;
+  // Else the label is at the end of the data
+  } else {
+    // Copy the label in the arena as the mapping may end exactly here
+    size_t length = end - c;
+    *label = (char*)CloudGraphArenaAlloc(cloud, 
+      sizeof(char) * (length + 1));
+    *ptr = end;
+    // If we couldn't allocate memory
+    if (*label == NULL) {
+      // Use a non NULL value to report the memory allocation failure
+      *label = c;
+      return false;
+    }
+    memcpy(*label, c, length);
+    (*label)[length] = '\0';
+  }
+  // Return the success code
+  return true;
+}
+
+// Return true if 'label' points into the memory mapping of 'cloud',
+// in which case it must not be freed
+bool CloudGraphIsMappedLabel(CloudGraph *cloud, char *label) {
+  // Check arguments
+  if (cloud == NULL || label == NULL || cloud->_map == NULL)
+    return false;
+  // Return the result
+  return (label >= cloud->_map && label < cloud->_map + cloud->_mapSize);
+}
+
+// Save the CloudGraph 'cloud' into the file 'path' in the binary 
+// format (see CLOUDGRAPH_BINVERSION)
+// Links are grouped by their first node, in the order of the nodes, 
+// a link is saved as many times as its weight
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: too large for the binary format, too many links counting the 
+// weights (INT_MAX) or too long labels in total (UINT32_MAX bytes)
+// 4: can't write the file
+int CloudGraphSaveBinary(CloudGraph *cloud, const char *path) {
+  // Check arguments
+  if (cloud == NULL || path == NULL)
+    return 1;
+  // Get the number of elements
+  int nbFamily = cloud->_families->_nbElem;
+  int nbNode = cloud->_nodes->_nbElem;
+  // Declare a variable to memorize the row of each node in the CSR, 
+  // indexed by node ID
+  int *row = (int*)malloc(sizeof(int) * 
+    (cloud->_nodeIndexSize > 0 ? cloud->_nodeIndexSize : 1));
+  // Declare a variable to memorize the offset of each row in the CSR
+  uint32_t *offset = (uint32_t*)malloc(sizeof(uint32_t) * (nbNode + 1));
+  if (row == NULL || offset == NULL) {
+    if (row != NULL) free(row);
+    if (offset != NULL) free(offset);
+    return 2;
+  }
+  // Calculate the size of the string pool and the row of each node
+  size_t poolSize = 0;
+  GSetElem *ptr = cloud->_families->_head;
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    if (family->_label != NULL)
+      poolSize += strlen(family->_label) + 1;
     ptr = ptr->_next;
-    // Increment the index of the node
-    ++iNode;
   }
-  // Calculate the family position
-  for (int iFamily = cloud->_families->_nbElem; iFamily--;)
-    if (nbFamily[iFamily] != 0)
-      posFamily[iFamily] /= (float)(nbFamily[iFamily]);
-  // Set the pointer to the head of the set of links
+  int iRow = 0;
+  ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    if (node->_label != NULL)
+      poolSize += strlen(node->_label) + 1;
+    row[node->_id] = iRow;
+    offset[iRow] = 0;
+    ++iRow;
+    ptr = ptr->_next;
+  }
+  offset[nbNode] = 0;
+  // Count the links per row, links toward unknown nodes are skipped,
+  // a bundle counts as many links as its weight
+  // The total is kept under INT_MAX, the limit of CloudGraphLoadBinary,
+  // so the counts can't overflow
+  uint32_t total = 0;
   ptr = cloud->_links->_head;
-  // Loop on the links
   while (ptr != NULL) {
     CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
-    // Get the two nodes of this link
-    CloudGraphNode *nodes[2];
-    for (int iNode = 2; iNode--;)
-      nodes[iNode] = CloudGraphGetNode(cloud, link->_nodes[iNode]);
-    if (nodes[0] != NULL && nodes[1] != NULL) {
-      // Set the values of the BCurve for this link
-      VecCopy(link->_curve->_ctrl[0], nodes[0]->_pos);
-      VecCopy(link->_curve->_ctrl[1], nodes[0]->_pos);
-      VecCopy(link->_curve->_ctrl[2], nodes[1]->_pos);
-      VecCopy(link->_curve->_ctrl[3], nodes[1]->_pos);
-      float dist = VecDist(nodes[0]->_pos, nodes[1]->_pos);
-      VecOp(link->_curve->_ctrl[1], 1.0, nodes[0]->_right, 
-        -1.0 * dist * opt->_curvature);
-      VecOp(link->_curve->_ctrl[2], 1.0, nodes[1]->_right, 
-        -1.0 * dist * opt->_curvature);
-      // Memorize the family of each node
-      for (int iNode = 2; iNode--;)
-        link->_families[iNode] = nodes[iNode]->_family;
-    }
-    // Move to next link
+    if (CloudGraphGetNode(cloud, link->_nodes[0]) != NULL &&
+      CloudGraphGetNode(cloud, link->_nodes[1]) != NULL) {
+      if ((uint32_t)(link->_weight) > (uint32_t)INT_MAX - total) {
+        free(row);
+        free(offset);
+        return 3;
+      }
+      total += (uint32_t)(link->_weight);
+      offset[row[link->_nodes[0]] + 1] += (uint32_t)(link->_weight);
+    }
     ptr = ptr->_next;
   }
-  // Set the pointer to the head of the set of families
+  for (iRow = 0; iRow < nbNode; ++iRow)
+    offset[iRow + 1] += offset[iRow];
+  int nbLink = (int)(offset[nbNode]);
+  // Calculate the size of the file and allocate memory for its content
+  size_t sizeFamilies = (size_t)nbFamily * CLOUDGRAPH_BINSIZEFAMILY;
+  size_t sizeNodes = (size_t)nbNode * CLOUDGRAPH_BINSIZENODE;
+  size_t sizeCSR = sizeof(uint32_t) * ((size_t)nbNode + 1 + nbLink);
+  size_t size = CLOUDGRAPH_BINSIZEHEADER + sizeFamilies + sizeNodes + 
+    sizeCSR + poolSize;
+  // The size of the string pool is stored on 32 bits
+  if (poolSize > UINT32_MAX) {
+    free(row);
+    free(offset);
+    return 3;
+  }
+  unsigned char *buffer = (unsigned char*)calloc(size, 1);
+  if (buffer == NULL) {
+    free(row);
+    free(offset);
+    return 2;
+  }
+  // Declare pointers to each section of the file
+  unsigned char *bufFamilies = buffer + CLOUDGRAPH_BINSIZEHEADER;
+  unsigned char *bufNodes = bufFamilies + sizeFamilies;
+  unsigned char *bufOffsets = bufNodes + sizeNodes;
+  unsigned char *bufTargets = bufOffsets + 
+    sizeof(uint32_t) * ((size_t)nbNode + 1);
+  char *pool = (char*)(bufTargets + sizeof(uint32_t) * (size_t)nbLink);
+  uint32_t iPool = 0;
+  // Set the header
+  memcpy(buffer, CLOUDGRAPH_BINMAGIC, 4);
+  CloudGraphPutU32(buffer + 4, CLOUDGRAPH_BINVERSION);
+  CloudGraphPutU32(buffer + 8, (uint32_t)nbFamily);
+  CloudGraphPutU32(buffer + 12, (uint32_t)nbNode);
+  CloudGraphPutU32(buffer + 16, (uint32_t)nbLink);
+  CloudGraphPutU32(buffer + 20, (uint32_t)poolSize);
+  // Set the families
   ptr = cloud->_families->_head;
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    CloudGraphPutU32(bufFamilies, (uint32_t)(family->_id));
+    memcpy(bufFamilies + 4, family->_rgba, 4);
+    CloudGraphPutU32(bufFamilies + 8, CLOUDGRAPH_BINNOLABEL);
+    if (family->_label != NULL) {
+      CloudGraphPutU32(bufFamilies + 8, iPool);
+      size_t length = strlen(family->_label) + 1;
+      memcpy(pool + iPool, family->_label, length);
+      iPool += length;
+    }
+    bufFamilies += CLOUDGRAPH_BINSIZEFAMILY;
+    ptr = ptr->_next;
+  }
+  // Set the nodes
+  ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    CloudGraphPutU32(bufNodes, (uint32_t)(node->_id));
+    CloudGraphPutU32(bufNodes + 4, (uint32_t)(node->_family));
+    CloudGraphPutU32(bufNodes + 8, CLOUDGRAPH_BINNOLABEL);
+    if (node->_label != NULL) {
+      CloudGraphPutU32(bufNodes + 8, iPool);
+      size_t length = strlen(node->_label) + 1;
+      memcpy(pool + iPool, node->_label, length);
+      iPool += length;
+    }
+    bufNodes += CLOUDGRAPH_BINSIZENODE;
+    ptr = ptr->_next;
+  }
+  // Set the CSR offsets
+  for (iRow = 0; iRow <= nbNode; ++iRow)
+    CloudGraphPutU32(bufOffsets + sizeof(uint32_t) * iRow, offset[iRow]);
+  // Set the CSR targets, the offsets are used as insertion cursors
+  ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    if (CloudGraphGetNode(cloud, link->_nodes[0]) != NULL &&
+      CloudGraphGetNode(cloud, link->_nodes[1]) != NULL) {
+      uint32_t *cursor = offset + row[link->_nodes[0]];
+      for (int iWeight = link->_weight; iWeight--;) {
+        CloudGraphPutU32(bufTargets + sizeof(uint32_t) * (*cursor), 
+          (uint32_t)(link->_nodes[1]));
+        ++(*cursor);
+      }
+    }
+    ptr = ptr->_next;
+  }
+  // Free memory
+  free(row);
+  free(offset);
+  // Write the file in one go
+  int ret = 0;
+  FILE *stream = fopen(path, "wb");
+  if (stream == NULL) {
+    ret = 4;
+  } else {
+    if (fwrite(buffer, 1, size, stream) != size)
+      ret = 4;
+    if (fclose(stream) != 0)
+      ret = 4;
+  }
+  // Free memory
+  free(buffer);
+  // Return the result code
+  return ret;
+}
+
+// Load the CloudGraph from the file 'path' in the binary format saved
+// by CloudGraphSaveBinary
+// The file is memory mapped, labels of nodes and families point into 
+// its string pool, and the mapping is owned by the CloudGraph and 
+// released by CloudGraphFree
+// If 'cloud' is not NULL it is first freed
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: invalid data (including unknown magic number or version, and 
+// IDs of INT_MAX / 2 or more)
+// 4: can't open or map the file, or truncated file
+int CloudGraphLoadBinary(CloudGraph **cloud, const char *path) {
+  // Check arguments
+  if (cloud == NULL || path == NULL)
+    return 1;
+  // Memorize the mode of the links of the cloud
+  bool lazyLinks = (*cloud != NULL && (*cloud)->_lazyLinks);
+  bool bundleLinks = (*cloud != NULL && (*cloud)->_bundleLinks);
+  // If cloud already exists
+  if (*cloud != NULL)
+    // Free it
+    CloudGraphFree(cloud);
+  // Open the file
+  int fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return 4;
+  // Get the size of the file
+  struct stat st;
+  if (fstat(fd, &st) == -1 || st.st_size < CLOUDGRAPH_BINSIZEHEADER) {
+    close(fd);
+    return 4;
+  }
+  // Map the file
+  size_t size = (size_t)(st.st_size);
+  unsigned char *map = (unsigned char*)mmap(NULL, size, 
+    PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return 4;
+  // Check the header
+  if (memcmp(map, CLOUDGRAPH_BINMAGIC, 4) != 0 ||
+    CloudGraphGetU32(map + 4) != CLOUDGRAPH_BINVERSION) {
+    munmap(map, size);
+    return 3;
+  }
+  uint32_t nbFamily = CloudGraphGetU32(map + 8);
+  uint32_t nbNode = CloudGraphGetU32(map + 12);
+  uint32_t nbLink = CloudGraphGetU32(map + 16);
+  uint32_t poolSize = CloudGraphGetU32(map + 20);
+  // Check the size of the file against the header
+  uint64_t expected = (uint64_t)CLOUDGRAPH_BINSIZEHEADER + 
+    (uint64_t)nbFamily * CLOUDGRAPH_BINSIZEFAMILY + 
+    (uint64_t)nbNode * CLOUDGRAPH_BINSIZENODE + 
+    sizeof(uint32_t) * ((uint64_t)nbNode + 1 + nbLink) + poolSize;
+  if (nbFamily > INT_MAX || nbNode > INT_MAX || nbLink > INT_MAX) {
+    munmap(map, size);
+    return 3;
+  }
+  if (expected > (uint64_t)size) {
+    munmap(map, size);
+    return 4;
+  }
+  // Check the IDs of the families and nodes, and the families of the 
+  // nodes, before reserving the indexes (negative IDs are read as 
+  // values above CLOUDGRAPH_BINMAXID)
+  unsigned char *rec = map + CLOUDGRAPH_BINSIZEHEADER;
+  for (uint32_t iFamily = 0; iFamily < nbFamily; ++iFamily) {
+    if (CloudGraphGetU32(rec) >= CLOUDGRAPH_BINMAXID) {
+      munmap(map, size);
+      return 3;
+    }
+    rec += CLOUDGRAPH_BINSIZEFAMILY;
+  }
+  for (uint32_t iNode = 0; iNode < nbNode; ++iNode) {
+    if (CloudGraphGetU32(rec) >= CLOUDGRAPH_BINMAXID ||
+      CloudGraphGetU32(rec + 4) >= CLOUDGRAPH_BINMAXID) {
+      munmap(map, size);
+      return 3;
+    }
+    rec += CLOUDGRAPH_BINSIZENODE;
+  }
+  // Create the cloud
+  *cloud = CloudGraphCreate();
+  if (*cloud == NULL) {
+    munmap(map, size);
+    return 2;
+  }
+  (*cloud)->_lazyLinks = lazyLinks;
+  (*cloud)->_bundleLinks = bundleLinks;
+  // Give the mapping to the cloud, it will be released with it
+  (*cloud)->_map = (char*)map;
+  (*cloud)->_mapSize = size;
+  // Declare pointers to each section of the file
+  unsigned char *bufFamilies = map + CLOUDGRAPH_BINSIZEHEADER;
+  unsigned char *bufNodes = bufFamilies + 
+    (size_t)nbFamily * CLOUDGRAPH_BINSIZEFAMILY;
+  unsigned char *bufOffsets = bufNodes + 
+    (size_t)nbNode * CLOUDGRAPH_BINSIZENODE;
+  unsigned char *bufTargets = bufOffsets + 
+    sizeof(uint32_t) * ((size_t)nbNode + 1);
+  char *pool = (char*)(bufTargets + sizeof(uint32_t) * (size_t)nbLink);
+  // The last string of the pool must be terminated, then any offset 
+  // in the pool gives a terminated label
+  if (poolSize > 0 && pool[poolSize - 1] != '\0') {
+    CloudGraphFree(cloud);
+    return 3;
+  }
+  // Reserve the indexes at once
+  if ((nbFamily > 0 && 
+    CloudGraphReserveFamilyIndex(*cloud, nbFamily - 1) == false) ||
+    (nbNode > 0 && 
+    CloudGraphReserveNodeIndex(*cloud, nbNode - 1) == false)) {
+    CloudGraphFree(cloud);
+    return 2;
+  }
+  // Declare a variable for the result code
+  int ret = 0;
+  // Load the families
+  for (uint32_t iFamily = 0; iFamily < nbFamily && ret == 0; 
+    ++iFamily) {
+    unsigned char *rec = bufFamilies + 
+      (size_t)iFamily * CLOUDGRAPH_BINSIZEFAMILY;
+    uint32_t lbl = CloudGraphGetU32(rec + 8);
+    CloudGraphFamily *family = CloudGraphArenaCreateFamily(*cloud);
+    if (family == NULL) {
+      ret = 2;
+    } else if (lbl != CLOUDGRAPH_BINNOLABEL && lbl >= poolSize) {
+      CloudGraphReleaseFamily(*cloud, &family);
+      ret = 3;
+    } else {
+      family->_id = (int)CloudGraphGetU32(rec);
+      memcpy(family->_rgba, rec + 4, 4);
+      if (lbl != CLOUDGRAPH_BINNOLABEL)
+        family->_label = pool + lbl;
+      if (CloudGraphAppendFamily(*cloud, family) == false) {
+        CloudGraphReleaseFamily(*cloud, &family);
+        ret = 3;
+      }
+    }
+  }
+  // Load the nodes
+  for (uint32_t iNode = 0; iNode < nbNode && ret == 0; ++iNode) {
+    unsigned char *rec = bufNodes + 
+      (size_t)iNode * CLOUDGRAPH_BINSIZENODE;
+    uint32_t lbl = CloudGraphGetU32(rec + 8);
+    CloudGraphNode *node = CloudGraphArenaCreateNode(*cloud);
+    if (node == NULL) {
+      ret = 2;
+    } else if ((lbl != CLOUDGRAPH_BINNOLABEL && lbl >= poolSize) ||
+      CloudGraphGetFamily(*cloud, 
+        (int)CloudGraphGetU32(rec + 4)) == NULL) {
+      CloudGraphReleaseNode(*cloud, &node);
+      ret = 3;
+    } else {
+      node->_id = (int)CloudGraphGetU32(rec);
+      node->_family = (int)CloudGraphGetU32(rec + 4);
+      if (lbl != CLOUDGRAPH_BINNOLABEL)
+        node->_label = pool + lbl;
+      if (CloudGraphAppendNode(*cloud, node) == false) {
+        CloudGraphReleaseNode(*cloud, &node);
+        ret = 3;
+      }
+    }
+  }
+  // Check the CSR offsets
+  if (ret == 0 && (CloudGraphGetU32(bufOffsets) != 0 ||
+    CloudGraphGetU32(bufOffsets + sizeof(uint32_t) * nbNode) != nbLink))
+    ret = 3;
+  // Load the links, created in the arena
+  for (uint32_t iRow = 0; iRow < nbNode && ret == 0; ++iRow) {
+    uint32_t from = CloudGraphGetU32(bufOffsets + sizeof(uint32_t) * iRow);
+    uint32_t to = 
+      CloudGraphGetU32(bufOffsets + sizeof(uint32_t) * (iRow + 1));
+    if (from > to || to > nbLink) {
+      ret = 3;
+    } else {
+      int idFrom = (int)CloudGraphGetU32(bufNodes + 
+        (size_t)iRow * CLOUDGRAPH_BINSIZENODE);
+      for (uint32_t iLink = from; iLink < to && ret == 0; ++iLink) {
+        int idTo = 
+          (int)CloudGraphGetU32(bufTargets + sizeof(uint32_t) * iLink);
+        if (CloudGraphGetNode(*cloud, idTo) == NULL)
+          ret = 3;
+        else
+          ret = CloudGraphAddLinkNodes(*cloud, idFrom, idTo);
+      }
+    }
+  }
+  // If the data couldn't be loaded
+  if (ret != 0)
+    // Free memory
+    CloudGraphFree(cloud);
+  // Return the result code
+  return ret;
+}
+
+// Write the unsigned integer 'v' at 'buf' in little-endian order
+void CloudGraphPutU32(unsigned char *buf, uint32_t v) {
+  buf[0] = (unsigned char)(v & 0xFF);
+  buf[1] = (unsigned char)((v >> 8) & 0xFF);
+  buf[2] = (unsigned char)((v >> 16) & 0xFF);
+  buf[3] = (unsigned char)((v >> 24) & 0xFF);
+}
+
+// Return the unsigned integer written at 'buf' in little-endian order
+uint32_t CloudGraphGetU32(const unsigned char *buf) {
+  return (uint32_t)(buf[0]) | ((uint32_t)(buf[1]) << 8) |
+    ((uint32_t)(buf[2]) << 16) | ((uint32_t)(buf[3]) << 24);
+}
+
+// Sort the nodes in the GSet in order of their families, and inside
+// a family in the order 'opt->_nodeOrder'
+// The family IDs are small integers, so the nodes are sorted with a 
+// stable counting sort in O(nodes + families) instead of GSetSort, 
+// and the GSet is relinked in the sorted order
+// Nodes of a family without ID in the index are placed before (for 
+// negative IDs) or after (for other IDs) the others, in the order in
+// which they were added
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphSortNodeByFamily(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  int nbNode = cloud->_nodes->_nbElem;
+  if (nbNode < 2)
+    return true;
+  // Get the degrees of the nodes if they are used
+  const CloudGraphAdjacency *adj = NULL;
+  if (opt->_nodeOrder == CloudGraphOptNodeOrderDegree) {
+    if (CloudGraphEnsureAdjacency(cloud) == false)
+      return false;
+    adj = &(cloud->_adj);
+  }
+  // Declare the keys: family ID + 1, 0 for negative IDs and 
+  // _familyIndexSize + 1 for the IDs beyond the index, and the degree
+  int nbKey = cloud->_familyIndexSize + 2;
+  int maxDegree = 0;
+  if (adj != NULL)
+    for (int iId = adj->_nbRow; iId--;)
+      if (adj->_degree[iId] > maxDegree)
+        maxDegree = adj->_degree[iId];
+  if (maxDegree + 1 > nbKey)
+    nbKey = maxDegree + 1;
+  // Allocate memory for the order of the elements and the counts
+  GSetElem **buffer = 
+    (GSetElem**)malloc(sizeof(GSetElem*) * nbNode * 2);
+  int *key = (int*)malloc(sizeof(int) * nbNode);
+  int *count = (int*)malloc(sizeof(int) * (nbKey + 1));
+  // If we couldn't allocate memory
+  if (buffer == NULL || key == NULL || count == NULL) {
+    if (buffer != NULL) free(buffer);
+    if (key != NULL) free(key);
+    if (count != NULL) free(count);
+    return false;
+  }
+  GSetElem **elem = buffer;
+  GSetElem **sorted = buffer + nbNode;
+  // Get the elements in the order in which they were added
+  GSetElem *ptr = cloud->_nodes->_head;
+  for (int iNode = 0; iNode < nbNode; ++iNode) {
+    elem[iNode] = ptr;
+    ptr = ptr->_next;
+  }
+  // If the nodes are ordered by degree inside their family, sort them
+  // first by decreasing degree, the sort by family below being stable
+  if (adj != NULL) {
+    for (int iNode = 0; iNode < nbNode; ++iNode) {
+      int id = ((CloudGraphNode*)(elem[iNode]->_data))->_id;
+      key[iNode] = maxDegree - adj->_degree[id];
+    }
+    CloudGraphCountingSort(elem, sorted, key, nbNode, count, 
+      maxDegree + 1);
+    GSetElem **swap = elem;
+    elem = sorted;
+    sorted = swap;
+  }
+  // Sort the elements by family
+  for (int iNode = 0; iNode < nbNode; ++iNode) {
+    int family = ((CloudGraphNode*)(elem[iNode]->_data))->_family;
+    key[iNode] = CloudGraphFamilyKey(cloud, family);
+  }
+  CloudGraphCountingSort(elem, sorted, key, nbNode, count, 
+    cloud->_familyIndexSize + 2);
+  // Relink the GSet in the sorted order
+  // The index of nodes stays valid as only the order of the elements
+  // in the GSet changes, not the nodes themselves
+  for (int iNode = 0; iNode < nbNode; ++iNode) {
+    sorted[iNode]->_prev = (iNode > 0 ? sorted[iNode - 1] : NULL);
+    sorted[iNode]->_next = 
+      (iNode < nbNode - 1 ? sorted[iNode + 1] : NULL);
+  }
+  cloud->_nodes->_head = sorted[0];
+  cloud->_nodes->_tail = sorted[nbNode - 1];
+  // Free memory
+  free(buffer);
+  free(key);
+  free(count);
+  // Return success code
+  return true;
+}
+
+// Sort stably the 'nb' elements 'elem' into 'sorted' by increasing 
+// 'key' in [0, 'nbKey'[, 'key' and 'count' ('nbKey' + 1 int) are 
+// indexed like 'elem' and used as temporary memory
+void CloudGraphCountingSort(GSetElem **elem, GSetElem **sorted, 
+  int *key, int nb, int *count, int nbKey) {
+  // Count the elements per key
+  memset(count, 0, sizeof(int) * (nbKey + 1));
+  for (int iElem = 0; iElem < nb; ++iElem)
+    ++(count[key[iElem] + 1]);
+  // Get the position of the first element of each key
+  for (int iKey = 0; iKey < nbKey; ++iKey)
+    count[iKey + 1] += count[iKey];
+  // Place the elements
+  for (int iElem = 0; iElem < nb; ++iElem)
+    sorted[(count[key[iElem]])++] = elem[iElem];
+}
+
+// Merge the nodes out of the order of their families in the GSet with
+// the nodes in order, as CloudGraphSortNodeByFamily with 
+// CloudGraphOptNodeOrderNone, sorting only the nodes out of order
+// The nodes whose family comes before the one of a previous node (the
+// added nodes, or the nodes of an added family) are unlinked, sorted 
+// stably by family and inserted after the nodes of their family, the
+// others staying in place, the GSet is left untouched if all the 
+// nodes are in order (only nodes have been removed)
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphMergeNodeByFamily(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return false;
+  // Count the nodes out of order
+  int nbKey = cloud->_familyIndexSize + 2;
+  int nbOut = 0;
+  int maxKey = 0;
+  GSetElem *ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    int key = CloudGraphFamilyKey(cloud, 
+      ((CloudGraphNode*)(ptr->_data))->_family);
+    if (key < maxKey)
+      ++nbOut;
+    else
+      maxKey = key;
+    ptr = ptr->_next;
+  }
+  // If the nodes are in order, nothing to do
+  if (nbOut == 0)
+    return true;
+  // Allocate memory for the nodes out of order and the counts
+  GSetElem **buffer = 
+    (GSetElem**)malloc(sizeof(GSetElem*) * nbOut * 2);
+  int *key = (int*)malloc(sizeof(int) * nbOut);
+  int *count = (int*)malloc(sizeof(int) * (nbKey + 1));
+  // If we couldn't allocate memory
+  if (buffer == NULL || key == NULL || count == NULL) {
+    if (buffer != NULL) free(buffer);
+    if (key != NULL) free(key);
+    if (count != NULL) free(count);
+    return false;
+  }
+  GSetElem **elem = buffer;
+  GSetElem **sorted = buffer + nbOut;
+  // Unlink the nodes out of order, in the order of the GSet
+  GSet *set = cloud->_nodes;
+  int iOut = 0;
+  maxKey = 0;
+  ptr = set->_head;
+  while (ptr != NULL) {
+    GSetElem *next = ptr->_next;
+    int k = CloudGraphFamilyKey(cloud, 
+      ((CloudGraphNode*)(ptr->_data))->_family);
+    if (k < maxKey) {
+      if (ptr->_prev != NULL)
+        ptr->_prev->_next = ptr->_next;
+      else
+        set->_head = ptr->_next;
+      if (ptr->_next != NULL)
+        ptr->_next->_prev = ptr->_prev;
+      else
+        set->_tail = ptr->_prev;
+      elem[iOut] = ptr;
+      key[iOut] = k;
+      ++iOut;
+    } else {
+      maxKey = k;
+    }
+    ptr = next;
+  }
+  // Sort them stably by family
+  CloudGraphCountingSort(elem, sorted, key, nbOut, count, nbKey);
+  // Insert each one before the first node of a later family, the 
+  // nodes of its family in order being all before it
+  ptr = set->_head;
+  for (iOut = 0; iOut < nbOut; ++iOut) {
+    GSetElem *out = sorted[iOut];
+    int k = CloudGraphFamilyKey(cloud, 
+      ((CloudGraphNode*)(out->_data))->_family);
+    while (ptr != NULL && CloudGraphFamilyKey(cloud, 
+      ((CloudGraphNode*)(ptr->_data))->_family) <= k)
+      ptr = ptr->_next;
+    out->_next = ptr;
+    out->_prev = (ptr != NULL ? ptr->_prev : set->_tail);
+    if (out->_prev != NULL)
+      out->_prev->_next = out;
+    else
+      set->_head = out;
+    if (ptr != NULL)
+      ptr->_prev = out;
+    else
+      set->_tail = out;
+  }
+  // Free memory
+  free(buffer);
+  free(key);
+  free(count);
+  // Return success code
+  return true;
+}
+
+// Arrange the position of the nodes of the graph in line
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeLine(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  // Declare a variable to calculate the position of families label
+  // They are indexed by the family ID
+  int nbFamilyId = cloud->_familyIndexSize;
+  float *posFamily = 
+    (float*)malloc(sizeof(float) * (nbFamilyId > 0 ? nbFamilyId : 1));
+  int *nbFamily = 
+    (int*)malloc(sizeof(int) * (nbFamilyId > 0 ? nbFamilyId : 1));
+  // If we couldn't allocate memory
+  if (posFamily == NULL || nbFamily == NULL) {
+    if (posFamily != NULL) free(posFamily);
+    if (nbFamily != NULL) free(nbFamily);
+    // Stop here
+    return false;
+  }
+  for (int iFamily = nbFamilyId; iFamily--;) {
+    posFamily[iFamily] = 0.0;
+    nbFamily[iFamily] = 0;
+  }
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Loop on the nodes
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    // Set the position of the node
+    cols->_x[iNode] = 0.0;
+    cols->_y[iNode] = 2.0 * opt->_fontSizeNode * ((float)iNode + 0.5);
+    // Calculate the family position
+    int idFamily = cols->_family[iNode];
+    if (idFamily >= 0 && idFamily < nbFamilyId) {
+      posFamily[idFamily] += cols->_y[iNode];
+      ++(nbFamily[idFamily]);
+    }
+    // Set the right of the node
+    cols->_rightX[iNode] = 1.0;
+    cols->_rightY[iNode] = 0.0;
+    // Set the angle with abciss
+    cols->_theta[iNode] = 0.0;
+  }
+  // Calculate the family position
+  for (int iFamily = nbFamilyId; iFamily--;)
+    if (nbFamily[iFamily] != 0)
+      posFamily[iFamily] /= (float)(nbFamily[iFamily]);
+  // Set the control points of the links
+  CloudGraphArrangeLinks(cloud, CloudGraphGetArrangeCurvature(opt), 
+    opt->_nbThread);
+  // Set the pointer to the head of the set of families
+  GSetElem *ptr = cloud->_families->_head;
   // Loop on the families
   while (ptr != NULL) {
     CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
     // Set the position
-    VecSet(family->_pos, 0, opt->_fontSizeNode);
-    VecSet(family->_pos, 1, posFamily[family->_id]);
+    family->_pos[0] = opt->_fontSizeNode;
+    family->_pos[1] = posFamily[family->_id];
     // Set the right direction
-    VecSet(family->_right, 0, 1.0);
-    VecSet(family->_right, 1, 0.0);
+    family->_right[0] = 1.0;
+    family->_right[1] = 0.0;
     // Move to next family
     ptr = ptr->_next;
   }
+  // Copy the result to the nodes and links
+  CloudGraphPushColumns(cloud, opt->_nbThread);
   // Free memory
   free(posFamily);
   free(nbFamily);
@@ -861,10 +4042,12 @@ bool CloudGraphArrangeCircle(CloudGraph *cloud, CloudGraphOpt *opt) {
   if (cloud == NULL || opt == NULL)
     return false;
   // Declare a variable to calculate the position of families label
+  // They are indexed by the family ID
+  int nbFamilyId = cloud->_familyIndexSize;
   float *posFamily = 
-    (float*)malloc(sizeof(float) * cloud->_families->_nbElem);
+    (float*)malloc(sizeof(float) * (nbFamilyId > 0 ? nbFamilyId : 1));
   int *nbFamily = 
-    (int*)malloc(sizeof(int) * cloud->_families->_nbElem);
+    (int*)malloc(sizeof(int) * (nbFamilyId > 0 ? nbFamilyId : 1));
   // If we couldn't allocate memory
   if (posFamily == NULL || nbFamily == NULL) {
     if (posFamily != NULL) free(posFamily);
@@ -872,273 +4055,3699 @@ bool CloudGraphArrangeCircle(CloudGraph *cloud, CloudGraphOpt *opt) {
     // Stop here
     return false;
   }
-  for (int iFamily = cloud->_families->_nbElem; iFamily--;) {
+  for (int iFamily = nbFamilyId; iFamily--;) {
     posFamily[iFamily] = 0.0;
     nbFamily[iFamily] = 0;
   }
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
   // Declare a variable to memorize the radius of the circle
-  float r = (float)(cloud->_nodes->_nbElem) *
-    opt->_fontSizeNode / PBMATH_PI;
-  // Declare a pointer toward the nodes
-  GSetElem *ptr = cloud->_nodes->_head;
+  float r = (float)(cols->_nbNode) * opt->_fontSizeNode / PBMATH_PI;
   // Declare variables to position the nodes
-  float theta = 0.0;
-  float dTheta = 2.0 * PBMATH_PI / (float)(cloud->_nodes->_nbElem);
+  // The cos and sin of the angle of the nodes are calculated by 
+  // rotating the previous ones of the angle between two nodes, and 
+  // calculated again every CLOUDGRAPH_ANGLERESYNC nodes
+  double dTheta = 2.0 * PBMATH_PI / (double)(cols->_nbNode);
+  double cosDTheta = cos(dTheta);
+  double sinDTheta = sin(dTheta);
+  double cosTheta = 1.0;
+  double sinTheta = 0.0;
   // Loop on the nodes
-  while (ptr != NULL) {
-    // Declare a pointer to the node
-    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    float theta = dTheta * (double)iNode;
+    if (iNode % CLOUDGRAPH_ANGLERESYNC == 0) {
+      cosTheta = cos(dTheta * (double)iNode);
+      sinTheta = sin(dTheta * (double)iNode);
+    }
     // Set the position of the node
-    VecSet(node->_pos, 0, r * cos(theta));
-    VecSet(node->_pos, 1, r * sin(theta));
+    cols->_x[iNode] = r * cosTheta;
+    cols->_y[iNode] = r * sinTheta;
     // Set the right of the node
-    VecSet(node->_right, 0, 1.0);
-    VecSet(node->_right, 1, 0.0);
-    VecRot2D(node->_right, theta);
+    cols->_rightX[iNode] = cosTheta;
+    cols->_rightY[iNode] = sinTheta;
     // Set the angle with abciss
-    node->_theta = theta;
+    cols->_theta[iNode] = theta;
     // Calculate the family position
-    posFamily[node->_family] += theta;
-    ++(nbFamily[node->_family]);
-    // Continue with the next node
-    ptr = ptr->_next;
-    // Increment the angle
-    theta += dTheta;
+    int idFamily = cols->_family[iNode];
+    if (idFamily >= 0 && idFamily < nbFamilyId) {
+      posFamily[idFamily] += theta;
+      ++(nbFamily[idFamily]);
+    }
+    // Rotate to the angle of the next node
+    double cosNext = cosTheta * cosDTheta - sinTheta * sinDTheta;
+    sinTheta = sinTheta * cosDTheta + cosTheta * sinDTheta;
+    cosTheta = cosNext;
   }
   // Calculate the family position
-  for (int iFamily = cloud->_families->_nbElem; iFamily--;)
+  for (int iFamily = nbFamilyId; iFamily--;)
     if (nbFamily[iFamily] != 0)
       posFamily[iFamily] /= (float)(nbFamily[iFamily]);
-  // Set the pointer to the head of the set of links
+  // Set the control points of the links
+  CloudGraphArrangeLinks(cloud, CloudGraphGetArrangeCurvature(opt), 
+    opt->_nbThread);
+  // Set the pointer to the head of the set of families
+  GSetElem *ptr = cloud->_families->_head;
+  // Loop on the families
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    // Set the right direction, rotated by the angle of the family
+    family->_right[0] = cos(posFamily[family->_id]);
+    family->_right[1] = sin(posFamily[family->_id]);
+    // Set the position
+    family->_pos[0] = (r + opt->_fontSizeNode) * family->_right[0];
+    family->_pos[1] = (r + opt->_fontSizeNode) * family->_right[1];
+    // Move to next family
+    ptr = ptr->_next;
+  }
+  // Copy the result to the nodes and links
+  CloudGraphPushColumns(cloud, opt->_nbThread);
+  // Free memory
+  free(posFamily);
+  free(nbFamily);
+  // Return success code
+  return true;
+}
+
+// Arrange the position of the nodes of the graph on rings
+// Each family is a sub-circle whose nodes are on concentric rings 
+// around its center, the radius of the sub-circle growing with the 
+// square root of the number of its nodes. The sub-circles are placed 
+// on an outer ring, each on an arc proportional to its radius, and 
+// the outer ring is large enough for the sub-circles not to overlap
+// The distances are then scaled for the TGA to fit in 
+// 'opt->_maxCanvas', the size of the canvas doesn't depend on the 
+// number of nodes
+// The right direction of the nodes points away from the center of the
+// graph
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeRings(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Count the families, the nodes are sorted by family so each family
+  // is a run of nodes
+  int nbRun = 0;
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode)
+    if (iNode == 0 || cols->_family[iNode] != cols->_family[iNode - 1])
+      ++nbRun;
+  // Declare variables to memorize the first node, the radius and the
+  // angle of each run, and the run of each family, indexed by the 
+  // family ID
+  int nbFamilyId = cloud->_familyIndexSize;
+  int *firstRun = (int*)malloc(sizeof(int) * (nbRun + 1));
+  float *radiusRun = 
+    (float*)malloc(sizeof(float) * (nbRun > 0 ? nbRun : 1));
+  double *angleRun = 
+    (double*)malloc(sizeof(double) * (nbRun > 0 ? nbRun : 1));
+  int *runFamily = 
+    (int*)malloc(sizeof(int) * (nbFamilyId > 0 ? nbFamilyId : 1));
+  // If we couldn't allocate memory
+  if (firstRun == NULL || radiusRun == NULL || angleRun == NULL || 
+    runFamily == NULL) {
+    if (firstRun != NULL) free(firstRun);
+    if (radiusRun != NULL) free(radiusRun);
+    if (angleRun != NULL) free(angleRun);
+    if (runFamily != NULL) free(runFamily);
+    // Stop here
+    return false;
+  }
+  for (int iFamily = nbFamilyId; iFamily--;)
+    runFamily[iFamily] = -1;
+  // Declare a variable to memorize the distance between nodes before 
+  // scaling
+  float dist = 2.0 * opt->_fontSizeNode;
+  // Calculate the radius of the runs, their sum and their maximum
+  float sumRadius = 0.0;
+  float maxRadius = 0.0;
+  int iRun = 0;
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    if (iNode == 0 || cols->_family[iNode] != cols->_family[iNode - 1]) {
+      firstRun[iRun] = iNode;
+      int idFamily = cols->_family[iNode];
+      if (idFamily >= 0 && idFamily < nbFamilyId)
+        runFamily[idFamily] = iRun;
+      ++iRun;
+    }
+  }
+  firstRun[nbRun] = cols->_nbNode;
+  for (iRun = 0; iRun < nbRun; ++iRun) {
+    // Get the number of rings needed for the nodes of the run
+    int nbNode = firstRun[iRun + 1] - firstRun[iRun];
+    int nbRing = 0;
+    for (int capacity = 1; capacity < nbNode;
+      capacity += CloudGraphRingCapacity(nbRing))
+      ++nbRing;
+    // The sub-circle is half a distance larger than its outer ring
+    radiusRun[iRun] = dist * ((float)nbRing + 0.5);
+    sumRadius += radiusRun[iRun];
+    if (radiusRun[iRun] > maxRadius)
+      maxRadius = radiusRun[iRun];
+  }
+  // Calculate the radius of the outer ring, such as two neighbour 
+  // sub-circles don't overlap
+  double radius = 0.0;
+  if (nbRun > 1) {
+    for (iRun = 0; iRun < nbRun; ++iRun) {
+      double sum = radiusRun[iRun] + radiusRun[(iRun + 1) % nbRun];
+      double r = 
+        sum / (2.0 * sin(PBMATH_PI * sum / (2.0 * sumRadius)));
+      if (r > radius)
+        radius = r;
+    }
+  }
+  // Calculate the angle of the center of the sub-circles
+  double arc = 0.0;
+  for (iRun = 0; iRun < nbRun; ++iRun) {
+    angleRun[iRun] = (nbRun > 1 ? 
+      PBMATH_PI * (2.0 * arc + radiusRun[iRun]) / sumRadius : 0.0);
+    arc += radiusRun[iRun];
+  }
+  // Get the scale of the layout
+  float scale = CloudGraphGetRingsScale(cloud, opt, radius + maxRadius);
+  // Loop on the runs
+  for (iRun = 0; iRun < nbRun; ++iRun) {
+    // Get the direction and center of the sub-circle
+    double dirX = cos(angleRun[iRun]);
+    double dirY = sin(angleRun[iRun]);
+    double centerX = scale * radius * dirX;
+    double centerY = scale * radius * dirY;
+    // Loop on the rings of the run
+    int iNode = firstRun[iRun];
+    for (int iRing = 0; iNode < firstRun[iRun + 1]; ++iRing) {
+      // Get the number of nodes on this ring, the last one may be
+      // incomplete and its nodes are spread on the whole ring
+      int nbNode = CloudGraphRingCapacity(iRing);
+      if (nbNode > firstRun[iRun + 1] - iNode)
+        nbNode = firstRun[iRun + 1] - iNode;
+      double dTheta = 2.0 * PBMATH_PI / (double)nbNode;
+      double r = scale * dist * (double)iRing;
+      // Loop on the nodes of the ring
+      for (int iNodeRing = 0; iNodeRing < nbNode; ++iNodeRing, ++iNode) {
+        // Set the position of the node, the rings start in the 
+        // direction of the sub-circle
+        double theta = angleRun[iRun] + dTheta * (double)iNodeRing;
+        double x = centerX + r * cos(theta);
+        double y = centerY + r * sin(theta);
+        cols->_x[iNode] = x;
+        cols->_y[iNode] = y;
+        // Set the right of the node, the node at the center of the 
+        // graph gets the direction of its sub-circle
+        double norm = sqrt(x * x + y * y);
+        if (norm > 0.0) {
+          cols->_rightX[iNode] = x / norm;
+          cols->_rightY[iNode] = y / norm;
+        } else {
+          cols->_rightX[iNode] = dirX;
+          cols->_rightY[iNode] = dirY;
+        }
+        // Set the angle with abciss
+        cols->_theta[iNode] = 
+          atan2(cols->_rightY[iNode], cols->_rightX[iNode]);
+      }
+    }
+  }
+  // Set the control points of the links
+  CloudGraphArrangeLinks(cloud, CloudGraphGetArrangeCurvature(opt), 
+    opt->_nbThread);
+  // Set the pointer to the head of the set of families
+  GSetElem *ptr = cloud->_families->_head;
+  // Loop on the families
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    // Get the run of the family
+    int run = (family->_id >= 0 && family->_id < nbFamilyId ? 
+      runFamily[family->_id] : -1);
+    // Set the position outside the sub-circle and the right 
+    // direction away from the center of the graph
+    double angle = (run >= 0 ? angleRun[run] : 0.0);
+    float r = (run >= 0 ? 
+      scale * (radius + radiusRun[run]) + opt->_fontSizeNode : 0.0);
+    family->_pos[0] = r * cos(angle);
+    family->_pos[1] = r * sin(angle);
+    family->_right[0] = cos(angle);
+    family->_right[1] = sin(angle);
+    // Move to next family
+    ptr = ptr->_next;
+  }
+  // Copy the result to the nodes and links
+  CloudGraphPushColumns(cloud, opt->_nbThread);
+  // Free memory
+  free(firstRun);
+  free(radiusRun);
+  free(angleRun);
+  free(runFamily);
+  // Return success code
+  return true;
+}
+
+// Arrange the position of the nodes of the graph with a 
+// force-directed layout
+// The nodes start on a spiral in the order of their families, then 
+// each iteration moves them along the sum of the forces on them: 
+// attraction along the links, repulsion between nodes (approximated 
+// with a Barnes-Hut quadtree, in O(N log N)), attraction toward the 
+// center of their family and toward the center of the graph
+// The nodes move by a step adapted to the decrease of the energy of 
+// the system, and the layout stops when the nodes don't move anymore,
+// or when the budget of 'opt' is reached
+// The right direction of the nodes points away from the center of the
+// graph
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeFree(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  int nbNode = cols->_nbNode;
+  // Declare the state of the layout
+  CloudGraphFreeLayout layout;
+  memset(&layout, 0, sizeof(CloudGraphFreeLayout));
+  layout._length = CLOUDGRAPH_FREELENGTH * opt->_fontSizeNode;
+  layout._familyForce = opt->_familyForce;
+  // Allocate memory
+  int nbKey = cloud->_familyIndexSize + 2;
+  int size = (nbNode > 0 ? nbNode : 1);
+  layout._leaf = (int*)malloc(sizeof(int) * size);
+  layout._order = (int*)malloc(sizeof(int) * size);
+  layout._forceX = (float*)malloc(sizeof(float) * size);
+  layout._forceY = (float*)malloc(sizeof(float) * size);
+  layout._familyX = (float*)malloc(sizeof(float) * nbKey);
+  layout._familyY = (float*)malloc(sizeof(float) * nbKey);
+  layout._familyNb = (int*)malloc(sizeof(int) * nbKey);
+  bool ret = (layout._leaf != NULL && layout._order != NULL && 
+    layout._forceX != NULL &&
+    layout._forceY != NULL && layout._familyX != NULL && 
+    layout._familyY != NULL && layout._familyNb != NULL);
+  // The attraction along the links uses the adjacency of the nodes
+  if (ret == true)
+    ret = CloudGraphEnsureAdjacency(cloud);
+  // Set the initial position of the nodes on a spiral, in the order of
+  // their families, each node covering the same area
+  for (int iNode = 0; ret == true && iNode < nbNode; ++iNode) {
+    double r = layout._length * sqrt((double)iNode + 0.5);
+    double theta = (double)iNode * PBMATH_PI * (3.0 - sqrt(5.0));
+    cols->_x[iNode] = r * cos(theta);
+    cols->_y[iNode] = r * sin(theta);
+  }
+  // Declare variables for the step of the nodes and the energy
+  // The first step is a tenth of the size of the initial layout
+  double step = 0.1 * layout._length * sqrt((double)nbNode);
+  double energyPrev = DBL_MAX;
+  int progress = 0;
+  // Declare variables for the time budget
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  // Loop on the iterations
+  for (int iIter = 0; ret == true && nbNode > 1 &&
+    iIter < opt->_freeMaxIter; ++iIter) {
+    // Calculate the center of the graph and of the families
+    for (int iKey = nbKey; iKey--;) {
+      layout._familyX[iKey] = 0.0;
+      layout._familyY[iKey] = 0.0;
+      layout._familyNb[iKey] = 0;
+    }
+    double centerX = 0.0;
+    double centerY = 0.0;
+    for (int iNode = 0; iNode < nbNode; ++iNode) {
+      int key = CloudGraphFamilyKey(cloud, cols->_family[iNode]);
+      layout._familyX[key] += cols->_x[iNode];
+      layout._familyY[key] += cols->_y[iNode];
+      ++(layout._familyNb[key]);
+      centerX += cols->_x[iNode];
+      centerY += cols->_y[iNode];
+    }
+    for (int iKey = nbKey; iKey--;) {
+      if (layout._familyNb[iKey] > 0) {
+        layout._familyX[iKey] /= (float)(layout._familyNb[iKey]);
+        layout._familyY[iKey] /= (float)(layout._familyNb[iKey]);
+      }
+    }
+    layout._centerX = centerX / (double)nbNode;
+    layout._centerY = centerY / (double)nbNode;
+    // Build the quadtree of the nodes
+    ret = CloudGraphBuildQuadtree(cloud, &layout);
+    if (ret == false)
+      break;
+    // Calculate the forces on the nodes, each thread on its own range 
+    // of nodes
+    CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+    int nbTask = CloudGraphSplitRanges(cloud, opt, opt->_nbThread, tasks);
+    for (int iTask = nbTask; iTask--;)
+      tasks[iTask]._free = &layout;
+    CloudGraphRunTasks(CloudGraphFreeForcesTask, tasks, nbTask);
+    // Move the nodes along their force, by the step at most, in the 
+    // calling thread to keep the energy independent of the number of
+    // threads
+    double energy = 0.0;
+    double move = 0.0;
+    for (int iNode = 0; iNode < nbNode; ++iNode) {
+      double fx = layout._forceX[iNode];
+      double fy = layout._forceY[iNode];
+      double f = sqrt(fx * fx + fy * fy);
+      energy += f * f;
+      if (f > 0.0) {
+        double d = (f < step ? f : step);
+        cols->_x[iNode] += fx / f * d;
+        cols->_y[iNode] += fy / f * d;
+        move += d;
+      }
+    }
+    // Adapt the step: grow it after several decreases of the energy,
+    // reduce it when the energy doesn't decrease
+    if (energy < energyPrev) {
+      ++progress;
+      if (progress >= CLOUDGRAPH_FREEPROGRESS) {
+        progress = 0;
+        step /= CLOUDGRAPH_FREECOOLING;
+      }
+    } else {
+      progress = 0;
+      step *= CLOUDGRAPH_FREECOOLING;
+    }
+    energyPrev = energy;
+    // If the nodes don't move anymore, stop here
+    if (move / (double)nbNode < CLOUDGRAPH_FREETOLERANCE * layout._length)
+      break;
+    // If the time budget is spent, stop here
+    if (opt->_freeMaxTime > 0.0) {
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      double elapsed = (double)(now.tv_sec - start.tv_sec) + 
+        (double)(now.tv_nsec - start.tv_nsec) * 1e-9;
+      if (elapsed >= opt->_freeMaxTime)
+        break;
+    }
+  }
+  if (ret == true) {
+    // Get the center of the graph and of the families
+    double centerX = 0.0;
+    double centerY = 0.0;
+    for (int iKey = nbKey; iKey--;) {
+      layout._familyX[iKey] = 0.0;
+      layout._familyY[iKey] = 0.0;
+      layout._familyNb[iKey] = 0;
+    }
+    for (int iNode = 0; iNode < nbNode; ++iNode) {
+      int key = CloudGraphFamilyKey(cloud, cols->_family[iNode]);
+      layout._familyX[key] += cols->_x[iNode];
+      layout._familyY[key] += cols->_y[iNode];
+      ++(layout._familyNb[key]);
+      centerX += cols->_x[iNode];
+      centerY += cols->_y[iNode];
+    }
+    if (nbNode > 0) {
+      centerX /= (double)nbNode;
+      centerY /= (double)nbNode;
+    }
+    // Set the right of the nodes, away from the center
+    for (int iNode = 0; iNode < nbNode; ++iNode) {
+      double dx = cols->_x[iNode] - centerX;
+      double dy = cols->_y[iNode] - centerY;
+      double d = sqrt(dx * dx + dy * dy);
+      cols->_rightX[iNode] = (d > 0.0 ? dx / d : 1.0);
+      cols->_rightY[iNode] = (d > 0.0 ? dy / d : 0.0);
+      cols->_theta[iNode] = atan2(cols->_rightY[iNode], 
+        cols->_rightX[iNode]);
+    }
+    // Set the control points of the links
+    CloudGraphArrangeLinks(cloud, CloudGraphGetArrangeCurvature(opt), 
+      opt->_nbThread);
+    // Set the pointer to the head of the set of families
+    GSetElem *ptr = cloud->_families->_head;
+    // Loop on the families
+    while (ptr != NULL) {
+      CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+      // Set the position at the center of the family, and the right 
+      // direction away from the center of the graph
+      int key = CloudGraphFamilyKey(cloud, family->_id);
+      float x = centerX;
+      float y = centerY;
+      if (layout._familyNb[key] > 0) {
+        x = layout._familyX[key] / (float)(layout._familyNb[key]);
+        y = layout._familyY[key] / (float)(layout._familyNb[key]);
+      }
+      family->_pos[0] = x;
+      family->_pos[1] = y;
+      double dx = x - centerX;
+      double dy = y - centerY;
+      double d = sqrt(dx * dx + dy * dy);
+      family->_right[0] = (d > 0.0 ? dx / d : 1.0);
+      family->_right[1] = (d > 0.0 ? dy / d : 0.0);
+      // Move to next family
+      ptr = ptr->_next;
+    }
+    // Copy the result to the nodes and links
+    CloudGraphPushColumns(cloud, opt->_nbThread);
+  }
+  // Free memory
+  void *arrays[] = {layout._quads, layout._leaf, layout._order, 
+    layout._rank, layout._count, layout._forceX, layout._forceY, 
+    layout._familyX, layout._familyY, layout._familyNb};
+  for (int iArr = sizeof(arrays) / sizeof(void*); iArr--;)
+    if (arrays[iArr] != NULL)
+      free(arrays[iArr]);
+  // Return success code
+  return ret;
+}
+
+// Build the quadtree of the nodes of 'cloud' in the free layout 
+// 'layout', and sort the nodes in its depth-first order
+// Each cell has the center of mass and number of its nodes, a leaf 
+// holds one node, or several if they are too close to be separated
+// Return false if memory allocation failed, else return true
+bool CloudGraphBuildQuadtree(CloudGraph *cloud, 
+  CloudGraphFreeLayout *layout) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Get the bounds of the nodes
+  float min[2] = {FLT_MAX, FLT_MAX};
+  float max[2] = {-FLT_MAX, -FLT_MAX};
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    if (cols->_x[iNode] < min[0]) min[0] = cols->_x[iNode];
+    if (cols->_x[iNode] > max[0]) max[0] = cols->_x[iNode];
+    if (cols->_y[iNode] < min[1]) min[1] = cols->_y[iNode];
+    if (cols->_y[iNode] > max[1]) max[1] = cols->_y[iNode];
+  }
+  // Create the root cell, a square containing all the nodes
+  if (layout->_capacityQuad < 1) {
+    if (CloudGraphRealloc((void**)&(layout->_quads), 
+      sizeof(CloudGraphQuad) * (4 * cols->_nbNode + 1)) == false)
+      return false;
+    layout->_capacityQuad = 4 * cols->_nbNode + 1;
+  }
+  CloudGraphQuad *root = layout->_quads;
+  memset(root, 0, sizeof(CloudGraphQuad));
+  root->_cx = 0.5 * (min[0] + max[0]);
+  root->_cy = 0.5 * (min[1] + max[1]);
+  root->_half = 0.5 * (max[0] - min[0] > max[1] - min[1] ? 
+    max[0] - min[0] : max[1] - min[1]) + layout->_length;
+  root->_child = -1;
+  root->_body = -1;
+  layout->_nbQuad = 1;
+  // Insert the nodes
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    float x = cols->_x[iNode];
+    float y = cols->_y[iNode];
+    int iQuad = 0;
+    for (int depth = 0;; ++depth) {
+      CloudGraphQuad *quad = layout->_quads + iQuad;
+      quad->_x += x;
+      quad->_y += y;
+      quad->_mass += 1.0;
+      // If the cell is a leaf
+      if (quad->_child < 0) {
+        // If the leaf was empty or can't be divided, the node goes in 
+        // it
+        if (quad->_body == -1 || depth >= CLOUDGRAPH_QUADMAXDEPTH) {
+          quad->_body = (quad->_body == -1 ? iNode : -2);
+          layout->_leaf[iNode] = iQuad;
+          break;
+        }
+        // Else divide the leaf
+        if (layout->_nbQuad + 4 > layout->_capacityQuad) {
+          int capacity = 2 * layout->_capacityQuad;
+          if (CloudGraphRealloc((void**)&(layout->_quads), 
+            sizeof(CloudGraphQuad) * capacity) == false)
+            return false;
+          layout->_capacityQuad = capacity;
+          quad = layout->_quads + iQuad;
+        }
+        quad->_child = layout->_nbQuad;
+        layout->_nbQuad += 4;
+        for (int iChild = 4; iChild--;) {
+          CloudGraphQuad *child = layout->_quads + quad->_child + iChild;
+          memset(child, 0, sizeof(CloudGraphQuad));
+          child->_half = 0.5 * quad->_half;
+          child->_cx = quad->_cx + ((iChild & 1) ? 1.0 : -1.0) * 
+            child->_half;
+          child->_cy = quad->_cy + ((iChild & 2) ? 1.0 : -1.0) * 
+            child->_half;
+          child->_child = -1;
+          child->_body = -1;
+        }
+        // Move the node of the leaf into its sub-cell
+        int body = quad->_body;
+        quad->_body = -1;
+        float bx = cols->_x[body];
+        float by = cols->_y[body];
+        int iSub = quad->_child + (bx >= quad->_cx ? 1 : 0) + 
+          (by >= quad->_cy ? 2 : 0);
+        CloudGraphQuad *sub = layout->_quads + iSub;
+        sub->_x = bx;
+        sub->_y = by;
+        sub->_mass = 1.0;
+        sub->_body = body;
+        layout->_leaf[body] = iSub;
+      }
+      // Move to the sub-cell of the node
+      iQuad = quad->_child + (x >= quad->_cx ? 1 : 0) + 
+        (y >= quad->_cy ? 2 : 0);
+    }
+  }
+  // Ensure the arrays to sort the nodes are large enough
+  if (CloudGraphRealloc((void**)&(layout->_rank), 
+    sizeof(int) * (layout->_capacityQuad + 1)) == false ||
+    CloudGraphRealloc((void**)&(layout->_count), 
+    sizeof(int) * (layout->_capacityQuad + 1)) == false)
+    return false;
+  // Get the rank of the cells in depth-first order, using _count as 
+  // the stack, and replace their sums of positions by their center of
+  // mass
+  int nbStack = 1;
+  int rank = 0;
+  layout->_count[0] = 0;
+  while (nbStack > 0) {
+    int iQuad = layout->_count[--nbStack];
+    CloudGraphQuad *quad = layout->_quads + iQuad;
+    layout->_rank[iQuad] = rank++;
+    if (quad->_mass > 0.0) {
+      quad->_x /= quad->_mass;
+      quad->_y /= quad->_mass;
+    }
+    if (quad->_child >= 0)
+      for (int iChild = 4; iChild--;)
+        layout->_count[nbStack++] = quad->_child + iChild;
+  }
+  // Sort the nodes by rank of their leaf
+  memset(layout->_count, 0, sizeof(int) * (layout->_nbQuad + 1));
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode)
+    ++(layout->_count[layout->_rank[layout->_leaf[iNode]] + 1]);
+  for (int iQuad = 0; iQuad < layout->_nbQuad; ++iQuad)
+    layout->_count[iQuad + 1] += layout->_count[iQuad];
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode)
+    layout->_order[
+      (layout->_count[layout->_rank[layout->_leaf[iNode]]])++] = iNode;
+  // Return success code
+  return true;
+}
+
+// Thread function calculating the forces on the nodes of a range in
+// the free layout
+// The forces only depend on the positions before the iteration, so 
+// the result doesn't depend on the ranges
+void* CloudGraphFreeForcesTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  CloudGraph *cloud = range->_cloud;
+  CloudGraphFreeLayout *layout = range->_free;
+  CloudGraphColumns *cols = &(cloud->_cols);
+  const CloudGraphAdjacency *adj = &(cloud->_adj);
+  float length = layout->_length;
+  float repulsion = CLOUDGRAPH_FREEREPULSION * length * length;
+  // Declare the stack of cells to visit in the quadtree
+  int stack[4 * (CLOUDGRAPH_QUADMAXDEPTH + 1)];
+  // Loop on the nodes of the range, in the order of the quadtree
+  for (int iOrder = range->_firstNode; iOrder < range->_lastNode; 
+    ++iOrder) {
+    int iNode = layout->_order[iOrder];
+    float x = cols->_x[iNode];
+    float y = cols->_y[iNode];
+    float fx = 0.0;
+    float fy = 0.0;
+    // Repulsion from the other nodes: far cells of the quadtree are 
+    // used as one mass at their center
+    int nbStack = 1;
+    stack[0] = 0;
+    while (nbStack > 0) {
+      int iQuad = stack[--nbStack];
+      const CloudGraphQuad *quad = layout->_quads + iQuad;
+      float mass = quad->_mass;
+      float dx = x - quad->_x;
+      float dy = y - quad->_y;
+      // Remove the node from its own leaf
+      if (iQuad == layout->_leaf[iNode]) {
+        if (mass <= 1.0)
+          continue;
+        dx = x - (quad->_x * mass - x) / (mass - 1.0);
+        dy = y - (quad->_y * mass - y) / (mass - 1.0);
+        mass -= 1.0;
+      } else if (mass <= 0.0) {
+        continue;
+      }
+      float dist2 = dx * dx + dy * dy;
+      // If the cell is not a leaf, and it contains the node or is too
+      // close for its size, visit its sub-cells
+      if (quad->_child >= 0 && 
+        ((fabsf(x - quad->_cx) <= quad->_half && 
+        fabsf(y - quad->_cy) <= quad->_half) ||
+        4.0 * quad->_half * quad->_half >= 
+        CLOUDGRAPH_FREETHETA * CLOUDGRAPH_FREETHETA * dist2)) {
+        for (int iChild = 4; iChild--;)
+          stack[nbStack++] = quad->_child + iChild;
+        continue;
+      }
+      // Nodes at the same position are pushed apart in a direction 
+      // depending on the node
+      if (dist2 < 1e-6 * length * length) {
+        dx = 1e-3 * length * cos((float)iNode);
+        dy = 1e-3 * length * sin((float)iNode);
+        dist2 = dx * dx + dy * dy;
+      }
+      float f = repulsion * mass / dist2;
+      fx += dx * f;
+      fy += dy * f;
+    }
+    // Attraction along the links, in proportion to the square of their
+    // length
+    int id = cols->_id[iNode];
+    for (int iNeighbor = adj->_offsets[id]; 
+      iNeighbor < adj->_offsets[id] + adj->_degree[id]; ++iNeighbor) {
+      int neighbor = cols->_col[adj->_neighbors[iNeighbor]];
+      float dx = cols->_x[neighbor] - x;
+      float dy = cols->_y[neighbor] - y;
+      float f = sqrtf(dx * dx + dy * dy) / length;
+      fx += dx * f;
+      fy += dy * f;
+    }
+    // Attraction toward the center of the family and of the graph, in
+    // proportion to the distance
+    int key = CloudGraphFamilyKey(cloud, cols->_family[iNode]);
+    fx += layout->_familyForce * (layout->_familyX[key] - x) +
+      CLOUDGRAPH_FREEGRAVITY * (layout->_centerX - x);
+    fy += layout->_familyForce * (layout->_familyY[key] - y) +
+      CLOUDGRAPH_FREEGRAVITY * (layout->_centerY - y);
+    layout->_forceX[iNode] = fx;
+    layout->_forceY[iNode] = fy;
+  }
+  return NULL;
+}
+
+// Return the curvature of the links in the arrangement of 'opt'
+// In line mode the links are always curved, in free mode they are 
+// straight unless curved links are requested
+double CloudGraphGetArrangeCurvature(CloudGraphOpt *opt) {
+  if (opt->_mode == CloudGraphModeCircle || 
+    opt->_mode == CloudGraphModeRings)
+    return opt->_curvature * 0.5;
+  if (opt->_mode == CloudGraphModeFree)
+    return (opt->_curvedLink ? opt->_curvature * 0.5 : 0.0);
+  return opt->_curvature;
+}
+
+// Return the number of nodes on the ring 'iRing' of a family in rings 
+// mode, the ring 0 being the center of the family
+// The nodes of the ring 'iRing' are at 'iRing' distances from the 
+// center, the ring holds as many nodes as distances in its perimeter
+int CloudGraphRingCapacity(int iRing) {
+  if (iRing == 0)
+    return 1;
+  return (int)floor(2.0 * PBMATH_PI * (double)iRing);
+}
+
+// Return the scale of the distances between nodes in rings mode for 
+// a layout at 'extent' from the center, such as the TGA including the
+// labels fits in 'opt->_maxCanvas'
+// The labels are not scaled, if they alone don't fit in the canvas the
+// layout is scaled to the size of one node and the canvas is larger
+// than 'opt->_maxCanvas'
+float CloudGraphGetRingsScale(CloudGraph *cloud, CloudGraphOpt *opt, 
+  float extent) {
+  // The control points of the links are at most at 
+  // 2 * curvature * extent from the center
+  double curvature = CloudGraphGetArrangeCurvature(opt);
+  if (curvature > 0.5)
+    extent *= 2.0 * curvature;
+  // If the layout is a single node there is nothing to scale
+  if (extent <= 0.0)
+    return 1.0;
+  // Declare a variable to memorize the margin between the layout and 
+  // the border of the TGA: the border of the bounding box and the 
+  // size of the nodes
+  float margin = 1.5 * opt->_fontSizeNode;
+  // If the node labels are displayed, add the longest one
+  float maxLength = 0.0;
+  if (opt->_nodeLabelMode != CloudGraphOptNodeLabelNone) {
+    GSetElem *ptr = cloud->_nodes->_head;
+    while (ptr != NULL) {
+      CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+      float width = 0.0;
+      float height = 0.0;
+      CloudGraphGetNodeLabelMetric(cloud, node, opt->_fontSizeNode,
+        &width, &height);
+      if (width > maxLength)
+        maxLength = width;
+      ptr = ptr->_next;
+    }
+    margin += maxLength + 2.0 * opt->_fontSizeNode;
+  }
+  // If the family labels are displayed, add the longest one, they are 
+  // beyond the node labels
+  if (opt->_familyLabelMode != CloudGraphOptFamilyLabelNone) {
+    float size = (opt->_fontSizeFamily > opt->_fontSizeNode ? 
+      opt->_fontSizeFamily : opt->_fontSizeNode);
+    maxLength = 0.0;
+    GSetElem *ptr = cloud->_families->_head;
+    while (ptr != NULL) {
+      CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+      float width = 0.0;
+      float height = 0.0;
+      CloudGraphGetLabelMetric(cloud, family->_label, size, &width, 
+        &height);
+      if (width > maxLength)
+        maxLength = width;
+      ptr = ptr->_next;
+    }
+    margin += maxLength + opt->_fontSizeNode + size;
+  }
+  // Get the space left to the layout in the half canvas
+  float space = 0.5 * opt->_maxCanvas - margin;
+  // If the labels alone don't fit, use the smallest visible layout
+  if (space < opt->_fontSizeNode)
+    space = opt->_fontSizeNode;
+  // Return the scale, the layout is never enlarged
+  return (extent > space ? space / extent : 1.0);
+}
+
+// Return the index of the family 'family' in the arrays indexed by 
+// family of 'cloud' (_familyIndexSize + 2 entries): 0 for negative 
+// IDs, _familyIndexSize + 1 for IDs beyond the index, else 'family' + 1
+int CloudGraphFamilyKey(CloudGraph *cloud, int family) {
+  return (family < 0 ? 0 : family < cloud->_familyIndexSize ? 
+    family + 1 : cloud->_familyIndexSize + 1);
+}
+
+// Set the control points of the links in the columns of 'cloud' from
+// the position and right direction of their nodes, using up to 
+// 'nbThread' threads
+// The intermediate control points are moved backward along the right 
+// direction of their node by the distance between the two nodes times
+// 'curvature'
+void CloudGraphArrangeLinks(CloudGraph *cloud, double curvature, 
+  int nbThread) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Memorize the curvature for the links without curve
+  cols->_curvature = curvature;
+  // Set the control points of the links with the fastest kernel, each
+  // thread on its own range of links
+  CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+  int nbTask = CloudGraphSplitRanges(cloud, NULL, nbThread, tasks);
+  for (int iTask = nbTask; iTask--;) {
+    tasks[iTask]._kernel = CloudGraphGetArrangeLinksKernel();
+    tasks[iTask]._curvature = curvature;
+  }
+  CloudGraphRunTasks(CloudGraphArrangeLinksTask, tasks, nbTask);
+}
+
+// Split the nodes and links of 'cloud' into ranges for up to 
+// 'nbThread' threads, the ranges are set into 'tasks' 
+// (CLOUDGRAPH_MAXTHREAD tasks) with the options 'opt'
+// There are at least CLOUDGRAPH_MINARRANGEPERTHREAD nodes or links per
+// range, and the ranges only depend on the number of threads, so the 
+// result of the threads is the same as with one thread
+// Return the number of ranges
+int CloudGraphSplitRanges(CloudGraph *cloud, CloudGraphOpt *opt, 
+  int nbThread, CloudGraphRangeTask *tasks) {
+  // Get the number of ranges
+  CloudGraphColumns *cols = &(cloud->_cols);
+  int nbElem = (cols->_nbNode > cols->_nbLink ? 
+    cols->_nbNode : cols->_nbLink);
+  int nbTask = nbElem / CLOUDGRAPH_MINARRANGEPERTHREAD;
+  if (nbTask > nbThread)
+    nbTask = nbThread;
+  if (nbTask > CLOUDGRAPH_MAXTHREAD)
+    nbTask = CLOUDGRAPH_MAXTHREAD;
+  if (nbTask < 1)
+    nbTask = 1;
+  // Set the ranges
+  for (int iTask = 0; iTask < nbTask; ++iTask) {
+    CloudGraphRangeTask *task = tasks + iTask;
+    task->_cloud = cloud;
+    task->_opt = opt;
+    task->_firstNode = (int)((long)(cols->_nbNode) * iTask / nbTask);
+    task->_lastNode = (int)((long)(cols->_nbNode) * (iTask + 1) / nbTask);
+    task->_firstLink = (int)((long)(cols->_nbLink) * iTask / nbTask);
+    task->_lastLink = (int)((long)(cols->_nbLink) * (iTask + 1) / nbTask);
+    task->_kernel = NULL;
+    task->_curvature = 0.0;
+    task->_free = NULL;
+    task->_render = NULL;
+  }
+  // Return the number of ranges
+  return nbTask;
+}
+
+// Run 'fun' on the 'nbTask' tasks 'tasks', one thread per task, the 
+// first task and the tasks whose thread can't be started are run in 
+// the calling thread
+void CloudGraphRunTasks(void* (*fun)(void*), CloudGraphRangeTask *tasks,
+  int nbTask) {
+  // Start the threads of the tasks but the first one
+  pthread_t threads[CLOUDGRAPH_MAXTHREAD];
+  bool started[CLOUDGRAPH_MAXTHREAD];
+  for (int iTask = 1; iTask < nbTask; ++iTask)
+    started[iTask] = (pthread_create(threads + iTask, NULL, fun, 
+      tasks + iTask) == 0);
+  // Run the first task, and the ones which couldn't be started
+  fun(tasks);
+  for (int iTask = 1; iTask < nbTask; ++iTask)
+    if (started[iTask] == false)
+      fun(tasks + iTask);
+  // Wait for the threads
+  for (int iTask = 1; iTask < nbTask; ++iTask)
+    if (started[iTask])
+      pthread_join(threads[iTask], NULL);
+}
+
+// Thread function setting the control points of the links of a range
+void* CloudGraphArrangeLinksTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  range->_kernel(&(range->_cloud->_cols), range->_firstLink, 
+    range->_lastLink, range->_curvature);
+  return NULL;
+}
+
+// Thread function copying the geometry of the links of a range from 
+// the columns to the links
+void* CloudGraphPushLinksTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  for (int iLink = range->_firstLink; iLink < range->_lastLink; ++iLink)
+    CloudGraphPushLink(range->_cloud, iLink);
+  return NULL;
+}
+
+// Thread function updating the bounding boxes of the links of a range
+void* CloudGraphLinkBoxesTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  // Loop through the links
+  for (int iLink = range->_firstLink; iLink < range->_lastLink; 
+    ++iLink)
+    CloudGraphUpdateLinkBox(range->_cloud, iLink);
+  return NULL;
+}
+
+// Thread function calculating the bounds of the nodes and links of a
+// range
+void* CloudGraphBoundsTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  CloudGraph *cloud = range->_cloud;
+  CloudGraphColumns *cols = &(cloud->_cols);
+  for (int iDim = 2; iDim--;) {
+    range->_min[iDim] = FLT_MAX;
+    range->_max[iDim] = -FLT_MAX;
+  }
+  // Loop through nodes
+  for (int iNode = range->_firstNode; iNode < range->_lastNode; 
+    ++iNode) {
+    CloudGraphNode *node = cols->_node[iNode];
+    CloudGraphExtendBounds(&(node->_boundingBox), range->_min, 
+      range->_max);
+    // if the node labels are displayed
+    if (range->_opt->_nodeLabelMode != CloudGraphOptNodeLabelNone)
+      CloudGraphExtendBounds(&(node->_boundingBoxLbl), range->_min, 
+        range->_max);
+  }
+  // Loop through the links
+  for (int iLink = range->_firstLink; iLink < range->_lastLink; 
+    ++iLink) {
+    float min[2];
+    float max[2];
+    if (CloudGraphGetLinkBounds(cloud, iLink, min, max)) {
+      for (int iDim = 2; iDim--;) {
+        if (min[iDim] < range->_min[iDim])
+          range->_min[iDim] = min[iDim];
+        if (max[iDim] > range->_max[iDim])
+          range->_max[iDim] = max[iDim];
+      }
+    }
+  }
+  return NULL;
+}
+
+// Extend the bounds 'min' and 'max' (2 floats each) to the box 'box'
+void CloudGraphExtendBounds(const CloudGraphBox *box, float *min, 
+  float *max) {
+  for (int iCorner = 4; iCorner--;) {
+    for (int iDim = 2; iDim--;) {
+      float v = box->_pos[iDim] + 
+        ((iCorner & 1) ? box->_axis[0][iDim] : 0.0) +
+        ((iCorner & 2) ? box->_axis[1][iDim] : 0.0);
+      if (v < min[iDim])
+        min[iDim] = v;
+      if (v > max[iDim])
+        max[iDim] = v;
+    }
+  }
+}
+
+// Return the fastest kernel setting the control points of links 
+// supported by the processor
+CloudGraphArrangeLinksKernel CloudGraphGetArrangeLinksKernel(void) {
+#ifdef CLOUDGRAPH_SIMDX86
+  // SSE is always available on x86-64, AVX2 is checked at runtime
+  if (__builtin_cpu_supports("avx2"))
+    return CloudGraphArrangeLinksAVX2;
+  return CloudGraphArrangeLinksSSE;
+#else
+  return CloudGraphArrangeLinksScalar;
+#endif
+}
+
+// Kernel setting the control points of the links without vector 
+// instructions
+void CloudGraphArrangeLinksScalar(CloudGraphColumns *cols, int first, 
+  int last, float curvature) {
+  for (int iLink = first; iLink < last; ++iLink)
+    CloudGraphArrangeLink(cols, iLink, curvature);
+}
+
+#ifdef CLOUDGRAPH_SIMDX86
+// Kernel setting the control points of the links with SSE 
+// instructions, 4 links at a time
+// SSE has no gather, the coordinates of the nodes are loaded one by 
+// one and the arithmetic is vectorized
+void CloudGraphArrangeLinksSSE(CloudGraphColumns *cols, int first, 
+  int last, float curvature) {
+  __m128 negCurvature = _mm_set1_ps(-curvature);
+  int iLink = first;
+  for (; iLink + 4 <= last; iLink += 4) {
+    // Get the nodes of the links, links toward an unknown node get 
+    // the node 0 and their result is cleared with 'valid'
+    int from[4];
+    int to[4];
+    int valid[4];
+    for (int i = 4; i--;) {
+      from[i] = cols->_from[iLink + i];
+      to[i] = cols->_to[iLink + i];
+      valid[i] = (from[i] >= 0 && to[i] >= 0 ? -1 : 0);
+      if (valid[i] == 0)
+        from[i] = to[i] = 0;
+    }
+    __m128 mask = _mm_castsi128_ps(_mm_loadu_si128((__m128i*)valid));
+    // Load the position and right direction of the nodes
+    __m128 xFrom = _mm_setr_ps(cols->_x[from[0]], cols->_x[from[1]], 
+      cols->_x[from[2]], cols->_x[from[3]]);
+    __m128 yFrom = _mm_setr_ps(cols->_y[from[0]], cols->_y[from[1]], 
+      cols->_y[from[2]], cols->_y[from[3]]);
+    __m128 xTo = _mm_setr_ps(cols->_x[to[0]], cols->_x[to[1]], 
+      cols->_x[to[2]], cols->_x[to[3]]);
+    __m128 yTo = _mm_setr_ps(cols->_y[to[0]], cols->_y[to[1]], 
+      cols->_y[to[2]], cols->_y[to[3]]);
+    __m128 rxFrom = _mm_setr_ps(cols->_rightX[from[0]], 
+      cols->_rightX[from[1]], cols->_rightX[from[2]], 
+      cols->_rightX[from[3]]);
+    __m128 ryFrom = _mm_setr_ps(cols->_rightY[from[0]], 
+      cols->_rightY[from[1]], cols->_rightY[from[2]], 
+      cols->_rightY[from[3]]);
+    __m128 rxTo = _mm_setr_ps(cols->_rightX[to[0]], cols->_rightX[to[1]],
+      cols->_rightX[to[2]], cols->_rightX[to[3]]);
+    __m128 ryTo = _mm_setr_ps(cols->_rightY[to[0]], cols->_rightY[to[1]],
+      cols->_rightY[to[2]], cols->_rightY[to[3]]);
+    // Calculate the shift of the intermediate control points
+    __m128 dx = _mm_sub_ps(xTo, xFrom);
+    __m128 dy = _mm_sub_ps(yTo, yFrom);
+    __m128 dist = _mm_sqrt_ps(
+      _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+    __m128 shift = _mm_mul_ps(dist, negCurvature);
+    // Calculate and store the intermediate control points
+    _mm_storeu_ps(cols->_c1x + iLink, _mm_and_ps(mask, 
+      _mm_add_ps(xFrom, _mm_mul_ps(rxFrom, shift))));
+    _mm_storeu_ps(cols->_c1y + iLink, _mm_and_ps(mask, 
+      _mm_add_ps(yFrom, _mm_mul_ps(ryFrom, shift))));
+    _mm_storeu_ps(cols->_c2x + iLink, _mm_and_ps(mask, 
+      _mm_add_ps(xTo, _mm_mul_ps(rxTo, shift))));
+    _mm_storeu_ps(cols->_c2y + iLink, _mm_and_ps(mask, 
+      _mm_add_ps(yTo, _mm_mul_ps(ryTo, shift))));
+  }
+  // Set the remaining links
+  CloudGraphArrangeLinksScalar(cols, iLink, last, curvature);
+}
+
+// Kernel setting the control points of the links with AVX2 
+// instructions, 8 links at a time
+void CloudGraphArrangeLinksAVX2(CloudGraphColumns *cols, int first, 
+  int last, float curvature) {
+  __m256 negCurvature = _mm256_set1_ps(-curvature);
+  __m256i zero = _mm256_setzero_si256();
+  int iLink = first;
+  for (; iLink + 8 <= last; iLink += 8) {
+    // Get the nodes of the links, links toward an unknown node get 
+    // the node 0 and their result is cleared with 'mask'
+    __m256i from = 
+      _mm256_loadu_si256((const __m256i*)(cols->_from + iLink));
+    __m256i to = _mm256_loadu_si256((const __m256i*)(cols->_to + iLink));
+    __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+      _mm256_or_si256(from, to), _mm256_set1_epi32(-1)));
+    from = _mm256_max_epi32(from, zero);
+    to = _mm256_max_epi32(to, zero);
+    // Gather the position and right direction of the nodes
+    __m256 xFrom = _mm256_i32gather_ps(cols->_x, from, 4);
+    __m256 yFrom = _mm256_i32gather_ps(cols->_y, from, 4);
+    __m256 xTo = _mm256_i32gather_ps(cols->_x, to, 4);
+    __m256 yTo = _mm256_i32gather_ps(cols->_y, to, 4);
+    __m256 rxFrom = _mm256_i32gather_ps(cols->_rightX, from, 4);
+    __m256 ryFrom = _mm256_i32gather_ps(cols->_rightY, from, 4);
+    __m256 rxTo = _mm256_i32gather_ps(cols->_rightX, to, 4);
+    __m256 ryTo = _mm256_i32gather_ps(cols->_rightY, to, 4);
+    // Calculate the shift of the intermediate control points
+    __m256 dx = _mm256_sub_ps(xTo, xFrom);
+    __m256 dy = _mm256_sub_ps(yTo, yFrom);
+    __m256 dist = _mm256_sqrt_ps(
+      _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    __m256 shift = _mm256_mul_ps(dist, negCurvature);
+    // Calculate and store the intermediate control points
+    _mm256_storeu_ps(cols->_c1x + iLink, _mm256_and_ps(mask, 
+      _mm256_add_ps(xFrom, _mm256_mul_ps(rxFrom, shift))));
+    _mm256_storeu_ps(cols->_c1y + iLink, _mm256_and_ps(mask, 
+      _mm256_add_ps(yFrom, _mm256_mul_ps(ryFrom, shift))));
+    _mm256_storeu_ps(cols->_c2x + iLink, _mm256_and_ps(mask, 
+      _mm256_add_ps(xTo, _mm256_mul_ps(rxTo, shift))));
+    _mm256_storeu_ps(cols->_c2y + iLink, _mm256_and_ps(mask, 
+      _mm256_add_ps(yTo, _mm256_mul_ps(ryTo, shift))));
+  }
+  // Set the remaining links
+  CloudGraphArrangeLinksScalar(cols, iLink, last, curvature);
+}
+#endif
+
+// Set the intermediate control points of the link at position 'iLink'
+// in the columns 'cols' as CloudGraphArrangeLinks with 'curvature'
+void CloudGraphArrangeLink(CloudGraphColumns *cols, int iLink, 
+  double curvature) {
+  // Get the two nodes of this link
+  int from = cols->_from[iLink];
+  int to = cols->_to[iLink];
+  if (from >= 0 && to >= 0) {
+    // Calculate the intermediate control points
+    float dx = cols->_x[to] - cols->_x[from];
+    float dy = cols->_y[to] - cols->_y[from];
+    // The calculation is in single precision, as in the vectorized 
+    // kernels, to get exactly the same result
+    float dist = sqrtf(dx * dx + dy * dy);
+    float shift = dist * -((float)curvature);
+    cols->_c1x[iLink] = cols->_x[from] + cols->_rightX[from] * shift;
+    cols->_c1y[iLink] = cols->_y[from] + cols->_rightY[from] * shift;
+    cols->_c2x[iLink] = cols->_x[to] + cols->_rightX[to] * shift;
+    cols->_c2y[iLink] = cols->_y[to] + cols->_rightY[to] * shift;
+  } else {
+    cols->_c1x[iLink] = cols->_c1y[iLink] = 0.0;
+    cols->_c2x[iLink] = cols->_c2y[iLink] = 0.0;
+  }
+}
+
+// Arrange the position of the nodes of the graph
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrange(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  CloudGraphInvalidateViews(cloud);
+  // Ensure the nodes are ordered by family
+  if (CloudGraphSortNodeByFamily(cloud, opt) == false)
+    return false;
+  // Build the columns in the order of the nodes
+  if (CloudGraphUpdateColumns(cloud) == false)
+    return false;
+  // If the layout cache is used
+  uint64_t hash = 0;
+  if (opt->_layoutCache != NULL) {
+    // If the layout for this graph and these options is in the cache
+    hash = CloudGraphLayoutHash(cloud, opt);
+    if (CloudGraphLoadLayout(cloud, opt, hash) == true) {
+      // Get the cached geometry into the columns
+      CloudGraphPullColumns(cloud);
+      // Memorize the curvature of the links as the arrangement would 
+      // have
+      cloud->_cols._curvature = CloudGraphGetArrangeCurvature(opt);
+      // The next changes can be processed incrementally
+      CloudGraphResetDirty(cloud, true);
+      // Nothing else to do
+      return true;
+    }
+  }
+  // Arrange the nodes and links
+  bool ret = CloudGraphArrangeNodes(cloud, opt);
+  // If the layout cache is used, save the layout
+  // A failure to save only means the next arrangement won't be cached
+  if (ret == true && opt->_layoutCache != NULL)
+    CloudGraphSaveLayout(cloud, opt, hash);
+  // If the graph is arranged, the next changes can be processed 
+  // incrementally
+  if (ret == true)
+    CloudGraphResetDirty(cloud, true);
+  // Return the success value
+  return ret;
+}
+
+// Set the position of the nodes and the control points of the links 
+// in the columns of 'cloud' according to 'opt->_mode', copy them to 
+// the nodes and links and update the bounding boxes
+// Return true if it could arrange nodes
+// Return false if it couldn't arrange nodes
+bool CloudGraphArrangeNodes(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Declare a variable for the return value
+  bool ret = true;
+  // Set initial position of nodes depending on representation mode
+  // If the representation is circle or free
+  if (opt->_mode == CloudGraphModeCircle) {
+    ret = CloudGraphArrangeCircle(cloud, opt);
+  } else if (opt->_mode == CloudGraphModeLine) {
+    ret = CloudGraphArrangeLine(cloud, opt);
+  } else if (opt->_mode == CloudGraphModeFree) {
+    ret = CloudGraphArrangeFree(cloud, opt);
+  } else if (opt->_mode == CloudGraphModeRings) {
+    ret = CloudGraphArrangeRings(cloud, opt);
+  }
+  // Update the bounding boxes of nodes and families' labels
+  CloudGraphUpdateBoundingBox(cloud, opt);
+  // Return the success value
+  return ret;
+}
+
+// Update the arrangement of the graph after nodes or links have been
+// added or removed since the last call to CloudGraphArrange or 
+// CloudGraphArrangeUpdate, 'opt' must be the options of this call
+// If only links have changed, only the control points and bounding 
+// box of the added links are calculated, and the bounding box of the
+// cloud is extended with them, or calculated again from the bounding 
+// boxes already calculated if a removed link was on its border
+// If nodes or families have changed, as the nodes are arranged by 
+// their rank in their family order, all the nodes and links are 
+// placed again, but the added nodes are merged in the order of the 
+// others instead of sorting all the nodes, the labels are not measured
+// again and the layout cache is not used
+// If the order of the nodes depends on the links (nodes ordered by 
+// their degree), or the position of the nodes depends on the links 
+// (CloudGraphModeFree), or the links have been bundled, the graph is
+// arranged again with CloudGraphArrange
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeUpdate(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return false;
+  CloudGraphInvalidateViews(cloud);
+  // Declare pointers to the columns and the changes
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphDirty *dirty = &(cloud->_dirty);
+  // If the changes couldn't be tracked, or the order of the nodes 
+  // may have changed with the degree of the nodes, or the nodes are 
+  // moved by the links in the free layout
+  if (dirty->_tracked == false ||
+    opt->_nodeOrder != CloudGraphOptNodeOrderNone ||
+    opt->_mode == CloudGraphModeFree)
+    // Arrange the whole graph
+    return CloudGraphArrange(cloud, opt);
+  // If nodes or families have changed, or the links couldn't be added
+  // to the columns
+  if (dirty->_relayout || cols->_valid == false) {
+    // Merge the added nodes in the family order, rebuild the columns 
+    // and place again all the nodes and links
+    if (CloudGraphMergeNodeByFamily(cloud) == false ||
+      CloudGraphUpdateColumns(cloud) == false ||
+      CloudGraphArrangeNodes(cloud, opt) == false)
+      return false;
+    // The changes have been processed
+    CloudGraphResetDirty(cloud, true);
+    return true;
+  }
+  // Get the bounds of the cloud and of its content, inside the border
+  // added by CloudGraphUnionBoundingBox
+  float margin = opt->_fontSizeNode;
+  float min[2];
+  float max[2];
+  bool shrink = false;
+  for (int iDim = 2; iDim--;) {
+    min[iDim] = VecGet(cloud->_boundingBox->_pos, iDim);
+    max[iDim] = min[iDim] + 
+      VecGet(cloud->_boundingBox->_axis[iDim], iDim);
+    // If a removed link was on the border of the content, the bounds 
+    // may shrink
+    if (dirty->_removedMin[iDim] <= min[iDim] + margin ||
+      dirty->_removedMax[iDim] >= max[iDim] - margin)
+      shrink = true;
+  }
+  // Loop on the dirty links
+  for (int iDirty = 0; iDirty < dirty->_nbLink; ++iDirty) {
+    int iLink = dirty->_links[iDirty];
+    CloudGraphLink *link = cols->_link[iLink];
+    // Set the control points of the link and copy them to the link
+    CloudGraphArrangeLink(cols, iLink, cols->_curvature);
+    CloudGraphPushLink(cloud, iLink);
+    link->_dirty = false;
+    // Update the bounding box of the link
+    CloudGraphUpdateLinkBox(cloud, iLink);
+    // Extend the bounds of the cloud with the link
+    float minLink[2];
+    float maxLink[2];
+    if (CloudGraphGetLinkBounds(cloud, iLink, minLink, maxLink)) {
+      for (int iDim = 2; iDim--;) {
+        if (minLink[iDim] - margin < min[iDim])
+          min[iDim] = minLink[iDim] - margin;
+        if (maxLink[iDim] + margin > max[iDim])
+          max[iDim] = maxLink[iDim] + margin;
+      }
+    }
+  }
+  // If the bounds may shrink
+  if (shrink) {
+    // Calculate them again from the bounding boxes
+    CloudGraphUnionBoundingBox(cloud, opt);
+  } else {
+    // Set the extended bounds
+    for (int iDim = 2; iDim--;) {
+      VecSet(cloud->_boundingBox->_pos, iDim, min[iDim]);
+      VecSet(cloud->_boundingBox->_axis[iDim], iDim, 
+        max[iDim] - min[iDim]);
+    }
+  }
+  // The changes have been processed
+  CloudGraphResetDirty(cloud, false);
+  // Return success code
+  return true;
+}
+
+// Return the hash of the content of the CloudGraph 'cloud' (families,
+// nodes in their current order, links, lazy links flag) and the 
+// options of 'opt' affecting the layout, used as the key of the layout
+// cache
+uint64_t CloudGraphLayoutHash(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Declare a variable for the hash, FNV-1a 64 bits
+  uint64_t hash = CLOUDGRAPH_FNVOFFSET;
+  // Hash the options, and the lazy links flag as the boxes of the 
+  // lazy links are not saved
+  int mode[7] = {opt->_mode, opt->_curvedLink, opt->_nodeLabelMode,
+    opt->_familyLabelMode, opt->_nodeOrder, opt->_freeMaxIter, 
+    cloud->_lazyLinks};
+  float size[6] = {opt->_curvature, opt->_fontSizeNode, 
+    opt->_fontSizeFamily, opt->_freeMaxTime, opt->_familyForce,
+    opt->_maxCanvas};
+  hash = CloudGraphHashBytes(hash, mode, sizeof(mode));
+  hash = CloudGraphHashBytes(hash, size, sizeof(size));
+  // Hash the families
+  GSetElem *ptr = cloud->_families->_head;
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    hash = CloudGraphHashBytes(hash, &(family->_id), sizeof(int));
+    hash = CloudGraphHashBytes(hash, family->_rgba, 4);
+    if (family->_label != NULL)
+      hash = CloudGraphHashBytes(hash, family->_label, 
+        strlen(family->_label) + 1);
+    ptr = ptr->_next;
+  }
+  // Hash the nodes
+  ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    hash = CloudGraphHashBytes(hash, &(node->_id), sizeof(int));
+    hash = CloudGraphHashBytes(hash, &(node->_family), sizeof(int));
+    if (node->_label != NULL)
+      hash = CloudGraphHashBytes(hash, node->_label, 
+        strlen(node->_label) + 1);
+    ptr = ptr->_next;
+  }
+  // Hash the links
   ptr = cloud->_links->_head;
-  // Loop on the links
   while (ptr != NULL) {
     CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
-    // Get the two nodes of this link
-    CloudGraphNode *nodes[2];
-    for (int iNode = 2; iNode--;)
-      nodes[iNode] = CloudGraphGetNode(cloud, link->_nodes[iNode]);
-    if (nodes[0] != NULL && nodes[1] != NULL) {
-      // Set the values of the BCurve for this link
-      VecCopy(link->_curve->_ctrl[0], nodes[0]->_pos);
-      VecCopy(link->_curve->_ctrl[1], nodes[0]->_pos);
-      VecCopy(link->_curve->_ctrl[2], nodes[1]->_pos);
-      VecCopy(link->_curve->_ctrl[3], nodes[1]->_pos);
-      float dist = VecDist(nodes[0]->_pos, nodes[1]->_pos);
-      VecOp(link->_curve->_ctrl[1], 1.0, nodes[0]->_right, 
-        -1.0 * dist * opt->_curvature * 0.5);
-      VecOp(link->_curve->_ctrl[2], 1.0, nodes[1]->_right, 
-        -1.0 * dist * opt->_curvature * 0.5);
-      // Memorize the family of each node
-      for (int iNode = 2; iNode--;)
-        link->_families[iNode] = nodes[iNode]->_family;
-    }
-    // Move to next link
+    hash = CloudGraphHashBytes(hash, link->_nodes, sizeof(int) * 2);
     ptr = ptr->_next;
   }
-  // Set the pointer to the head of the set of families
-  ptr = cloud->_families->_head;
-  // Loop on the families
-  while (ptr != NULL) {
-    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+  // Return the hash
+  return hash;
+}
+
+// Update the FNV-1a hash 'hash' with the 'size' bytes at 'data'
+// Return the updated hash
+uint64_t CloudGraphHashBytes(uint64_t hash, const void *data, 
+  size_t size) {
+  const unsigned char *byte = (const unsigned char*)data;
+  for (size_t iByte = 0; iByte < size; ++iByte) {
+    hash ^= byte[iByte];
+    hash *= CLOUDGRAPH_FNVPRIME;
+  }
+  return hash;
+}
+
+// Get in 'path' (of size 'size') the path of the file of the layout 
+// cache for the key 'hash' in the directory of 'opt'
+void CloudGraphLayoutCachePath(CloudGraphOpt *opt, uint64_t hash, 
+  char *path, size_t size) {
+  snprintf(path, size, "%s/%016llx.cgl", opt->_layoutCache, 
+    (unsigned long long)hash);
+}
+
+// Return the number of floats in a layout cache file for 'cloud'
+size_t CloudGraphLayoutCacheSize(CloudGraph *cloud) {
+  return CLOUDGRAPH_SIZELAYOUTBOX + 
+    (size_t)(cloud->_nodes->_nbElem) * CLOUDGRAPH_SIZELAYOUTNODE +
+    (size_t)(cloud->_links->_nbElem) * CLOUDGRAPH_SIZELAYOUTLINK +
+    (size_t)(cloud->_families->_nbElem) * CLOUDGRAPH_SIZELAYOUTFAMILY;
+}
+
+// Copy the position and axis of the 2D Shapoid 's' into 'v' (6 floats)
+// 'v' is set to 0.0 if 's' is NULL
+void CloudGraphShapoidToFloat(Shapoid *s, float *v) {
+  for (int i = 6; i--;)
+    v[i] = 0.0;
+  if (s == NULL)
+    return;
+  for (int iDim = 2; iDim--;) {
+    v[iDim] = VecGet(s->_pos, iDim);
+    v[2 + iDim] = VecGet(s->_axis[0], iDim);
+    v[4 + iDim] = VecGet(s->_axis[1], iDim);
+  }
+}
+
+// Set the position and axis of the 2D Shapoid '*s' from 'v' (6 
+// floats), the Shapoid is created as a Facoid if '*s' is NULL
+// Return false if the Shapoid couldn't be created, else return true
+bool CloudGraphFloatToShapoid(const float *v, Shapoid **s) {
+  if (*s == NULL)
+    *s = FacoidCreate(2);
+  if (*s == NULL)
+    return false;
+  for (int iDim = 2; iDim--;) {
+    VecSet((*s)->_pos, iDim, v[iDim]);
+    VecSet((*s)->_axis[0], iDim, v[2 + iDim]);
+    VecSet((*s)->_axis[1], iDim, v[4 + iDim]);
+  }
+  return true;
+}
+
+// Copy the position and axis of the box 'box' into 'v' (6 floats), 
+// in the same order as CloudGraphShapoidToFloat
+void CloudGraphBoxToFloat(const CloudGraphBox *box, float *v) {
+  for (int iDim = 2; iDim--;) {
+    v[iDim] = box->_pos[iDim];
+    v[2 + iDim] = box->_axis[0][iDim];
+    v[4 + iDim] = box->_axis[1][iDim];
+  }
+}
+
+// Set the position and axis of the box 'box' from 'v' (6 floats)
+void CloudGraphFloatToBox(const float *v, CloudGraphBox *box) {
+  for (int iDim = 2; iDim--;) {
+    box->_pos[iDim] = v[iDim];
+    box->_axis[0][iDim] = v[2 + iDim];
+    box->_axis[1][iDim] = v[4 + iDim];
+  }
+}
+
+// Load the layout of the CloudGraph 'cloud' for the key 'hash' from 
+// the layout cache of 'opt'
+// The nodes must already be sorted by family
+// Return true if the layout was found and applied, false else
+bool CloudGraphLoadLayout(CloudGraph *cloud, CloudGraphOpt *opt, 
+  uint64_t hash) {
+  // Open the cache file
+  char path[CLOUDGRAPH_MAXLENGTHPATH];
+  CloudGraphLayoutCachePath(opt, hash, path, sizeof(path));
+  FILE *stream = fopen(path, "rb");
+  if (stream == NULL)
+    return false;
+  // Read and check the header
+  uint32_t header[6];
+  size_t size = CloudGraphLayoutCacheSize(cloud);
+  if (fread(header, sizeof(uint32_t), 6, stream) != 6 ||
+    memcmp(header, CLOUDGRAPH_LAYOUTMAGIC, 4) != 0 ||
+    header[1] != CLOUDGRAPH_LAYOUTVERSION ||
+    header[2] != (uint32_t)(cloud->_families->_nbElem) ||
+    header[3] != (uint32_t)(cloud->_nodes->_nbElem) ||
+    header[4] != (uint32_t)(cloud->_links->_nbElem) ||
+    header[5] != (uint32_t)size) {
+    fclose(stream);
+    return false;
+  }
+  // Read the layout in one go
+  float *layout = (float*)malloc(sizeof(float) * size);
+  if (layout == NULL) {
+    fclose(stream);
+    return false;
+  }
+  bool ret = (fread(layout, sizeof(float), size, stream) == size);
+  fclose(stream);
+  // Check the order of the nodes
+  float *v = layout + CLOUDGRAPH_SIZELAYOUTBOX;
+  GSetElem *ptr = cloud->_nodes->_head;
+  while (ret == true && ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    int32_t id;
+    memcpy(&id, v, sizeof(int32_t));
+    if (id != node->_id)
+      ret = false;
+    v += CLOUDGRAPH_SIZELAYOUTNODE;
+    ptr = ptr->_next;
+  }
+  if (ret == false) {
+    free(layout);
+    return false;
+  }
+  // Apply the layout
+  v = layout;
+  ret = CloudGraphFloatToShapoid(v, &(cloud->_boundingBox));
+  v += CLOUDGRAPH_SIZELAYOUTBOX;
+  ptr = cloud->_nodes->_head;
+  while (ret == true && ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    for (int iDim = 2; iDim--;) {
+      node->_pos[iDim] = v[1 + iDim];
+      node->_right[iDim] = v[3 + iDim];
+    }
+    node->_theta = v[5];
+    CloudGraphFloatToBox(v + 6, &(node->_boundingBox));
+    CloudGraphFloatToBox(v + 12, &(node->_boundingBoxLbl));
+    v += CLOUDGRAPH_SIZELAYOUTNODE;
+    ptr = ptr->_next;
+  }
+  // The links are in the order of their columns, the control points 
+  // of lazy links are set directly in the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  for (int iLink = 0; ret == true && iLink < cols->_nbLink; ++iLink) {
+    CloudGraphLink *link = cols->_link[iLink];
+    for (int iNode = 2; iNode--;) {
+      int32_t family;
+      memcpy(&family, v + 8 + iNode, sizeof(int32_t));
+      link->_families[iNode] = family;
+    }
+    if (link->_lazy == false) {
+      for (int iCtrl = 4; iCtrl--;)
+        for (int iDim = 2; iDim--;)
+          link->_ctrl[iCtrl][iDim] = v[2 * iCtrl + iDim];
+      CloudGraphFloatToBox(v + 10, &(link->_boundingBox));
+    } else {
+      cols->_c1x[iLink] = v[2];
+      cols->_c1y[iLink] = v[3];
+      cols->_c2x[iLink] = v[4];
+      cols->_c2y[iLink] = v[5];
+    }
+    v += CLOUDGRAPH_SIZELAYOUTLINK;
+  }
+  ptr = cloud->_families->_head;
+  while (ret == true && ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    for (int iDim = 2; iDim--;) {
+      family->_pos[iDim] = v[iDim];
+      family->_right[iDim] = v[2 + iDim];
+    }
+    CloudGraphFloatToBox(v + 4, &(family->_boundingBox));
+    v += CLOUDGRAPH_SIZELAYOUTFAMILY;
+    ptr = ptr->_next;
+  }
+  // Free memory
+  free(layout);
+  // Return the result
+  return ret;
+}
+
+// Save the layout of the CloudGraph 'cloud' for the key 'hash' into 
+// the layout cache of 'opt'
+// The file is written under a temporary name and then renamed, so 
+// concurrent processes never read a partial layout
+// Return true if the layout could be saved, false else
+bool CloudGraphSaveLayout(CloudGraph *cloud, CloudGraphOpt *opt, 
+  uint64_t hash) {
+  // Allocate memory for the layout
+  size_t size = CloudGraphLayoutCacheSize(cloud);
+  float *layout = (float*)malloc(sizeof(float) * size);
+  if (layout == NULL)
+    return false;
+  // Get the layout
+  float *v = layout;
+  CloudGraphShapoidToFloat(cloud->_boundingBox, v);
+  v += CLOUDGRAPH_SIZELAYOUTBOX;
+  GSetElem *ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    int32_t id = node->_id;
+    memcpy(v, &id, sizeof(int32_t));
+    for (int iDim = 2; iDim--;) {
+      v[1 + iDim] = node->_pos[iDim];
+      v[3 + iDim] = node->_right[iDim];
+    }
+    v[5] = node->_theta;
+    CloudGraphBoxToFloat(&(node->_boundingBox), v + 6);
+    CloudGraphBoxToFloat(&(node->_boundingBoxLbl), v + 12);
+    v += CLOUDGRAPH_SIZELAYOUTNODE;
+    ptr = ptr->_next;
+  }
+  // The links are in the order of their columns, the control points 
+  // of lazy links are in the columns, their bounding box is null
+  CloudGraphColumns *cols = &(cloud->_cols);
+  for (int iLink = 0; iLink < cols->_nbLink; ++iLink) {
+    CloudGraphLink *link = cols->_link[iLink];
+    if (link->_lazy == false) {
+      for (int iCtrl = 4; iCtrl--;)
+        for (int iDim = 2; iDim--;)
+          v[2 * iCtrl + iDim] = link->_ctrl[iCtrl][iDim];
+    } else {
+      int from = cols->_from[iLink];
+      int to = cols->_to[iLink];
+      v[0] = (from >= 0 ? cols->_x[from] : 0.0);
+      v[1] = (from >= 0 ? cols->_y[from] : 0.0);
+      v[2] = cols->_c1x[iLink];
+      v[3] = cols->_c1y[iLink];
+      v[4] = cols->_c2x[iLink];
+      v[5] = cols->_c2y[iLink];
+      v[6] = (to >= 0 ? cols->_x[to] : 0.0);
+      v[7] = (to >= 0 ? cols->_y[to] : 0.0);
+    }
+    for (int iNode = 2; iNode--;) {
+      int32_t family = link->_families[iNode];
+      memcpy(v + 8 + iNode, &family, sizeof(int32_t));
+    }
+    CloudGraphBoxToFloat(&(link->_boundingBox), v + 10);
+    v += CLOUDGRAPH_SIZELAYOUTLINK;
+  }
+  ptr = cloud->_families->_head;
+  while (ptr != NULL) {
+    CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+    for (int iDim = 2; iDim--;) {
+      v[iDim] = family->_pos[iDim];
+      v[2 + iDim] = family->_right[iDim];
+    }
+    CloudGraphBoxToFloat(&(family->_boundingBox), v + 4);
+    v += CLOUDGRAPH_SIZELAYOUTFAMILY;
+    ptr = ptr->_next;
+  }
+  // Set the header
+  uint32_t header[6];
+  memcpy(header, CLOUDGRAPH_LAYOUTMAGIC, 4);
+  header[1] = CLOUDGRAPH_LAYOUTVERSION;
+  header[2] = (uint32_t)(cloud->_families->_nbElem);
+  header[3] = (uint32_t)(cloud->_nodes->_nbElem);
+  header[4] = (uint32_t)(cloud->_links->_nbElem);
+  header[5] = (uint32_t)size;
+  // Write the layout in a temporary file
+  char path[CLOUDGRAPH_MAXLENGTHPATH];
+  char pathTmp[CLOUDGRAPH_MAXLENGTHPATH + 32];
+  CloudGraphLayoutCachePath(opt, hash, path, sizeof(path));
+  snprintf(pathTmp, sizeof(pathTmp), "%s.%ld.tmp", path, 
+    (long)getpid());
+  bool ret = false;
+  FILE *stream = fopen(pathTmp, "wb");
+  if (stream != NULL) {
+    ret = (fwrite(header, sizeof(uint32_t), 6, stream) == 6 &&
+      fwrite(layout, sizeof(float), size, stream) == size);
+    if (fclose(stream) != 0)
+      ret = false;
+    // Move the temporary file to its final name
+    if (ret == true)
+      ret = (rename(pathTmp, path) == 0);
+    if (ret == false)
+      remove(pathTmp);
+  }
+  // Free memory
+  free(layout);
+  // Return the result
+  return ret;
+}
+
+// Rebuild the columns of 'cloud' from its sets of nodes and links, 
+// nodes are in the order of the set of nodes
+// The geometry in the columns is not set, see CloudGraphPullColumns
+// Return false if memory allocation failed, else return true
+bool CloudGraphUpdateColumns(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return false;
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  cols->_valid = false;
+  // Ensure the columns are large enough
+  int nbNode = cloud->_nodes->_nbElem;
+  int nbLink = cloud->_links->_nbElem;
+  if (CloudGraphColumnsReserve(cols, nbNode, nbLink, 
+    cloud->_nodeIndexSize) == false)
+    return false;
+  // Fill the node columns
+  for (int iId = cloud->_nodeIndexSize; iId--;)
+    cols->_col[iId] = -1;
+  int iNode = 0;
+  GSetElem *ptr = cloud->_nodes->_head;
+  while (ptr != NULL) {
+    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+    cols->_node[iNode] = node;
+    cols->_id[iNode] = node->_id;
+    cols->_family[iNode] = node->_family;
+    cols->_col[node->_id] = iNode;
+    ++iNode;
+    ptr = ptr->_next;
+  }
+  cols->_nbNode = nbNode;
+  // Fill the link columns, links toward unknown nodes get -1
+  int iLink = 0;
+  ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    cols->_link[iLink] = link;
+    link->_col = iLink;
+    cols->_from[iLink] = (link->_nodes[0] >= 0 && 
+      link->_nodes[0] < cloud->_nodeIndexSize ? 
+      cols->_col[link->_nodes[0]] : -1);
+    cols->_to[iLink] = (link->_nodes[1] >= 0 && 
+      link->_nodes[1] < cloud->_nodeIndexSize ? 
+      cols->_col[link->_nodes[1]] : -1);
+    ++iLink;
+    ptr = ptr->_next;
+  }
+  cols->_nbLink = nbLink;
+  cols->_valid = true;
+  // Return the success code
+  return true;
+}
+
+// Ensure the columns 'cols' can hold 'nbNode' nodes, 'nbLink' links 
+// and node IDs up to 'nbId' - 1
+// Return false if memory allocation failed, else return true
+bool CloudGraphColumnsReserve(CloudGraphColumns *cols, int nbNode, 
+  int nbLink, int nbId) {
+  // Declare a variable for the success of allocations
+  bool ret = true;
+  // If the node columns are too small
+  if (nbNode > cols->_capacityNode) {
+    int capacity = nbNode + nbNode / 2;
+    ret = 
+      CloudGraphRealloc((void**)&(cols->_node), 
+        sizeof(CloudGraphNode*) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_id), sizeof(int) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_family), 
+        sizeof(int) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_x), sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_y), sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_rightX), 
+        sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_rightY), 
+        sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_theta), 
+        sizeof(float) * capacity);
+    if (ret == false)
+      return false;
+    cols->_capacityNode = capacity;
+  }
+  // If the index of columns is too small
+  if (nbId > cols->_capacityCol) {
+    if (CloudGraphRealloc((void**)&(cols->_col), 
+      sizeof(int) * nbId) == false)
+      return false;
+    cols->_capacityCol = nbId;
+  }
+  // If the link columns are too small
+  if (nbLink > cols->_capacityLink) {
+    int capacity = nbLink + nbLink / 2;
+    ret = 
+      CloudGraphRealloc((void**)&(cols->_link), 
+        sizeof(CloudGraphLink*) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_from), sizeof(int) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_to), sizeof(int) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_c1x), 
+        sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_c1y), 
+        sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_c2x), 
+        sizeof(float) * capacity) &&
+      CloudGraphRealloc((void**)&(cols->_c2y), sizeof(float) * capacity);
+    if (ret == false)
+      return false;
+    cols->_capacityLink = capacity;
+  }
+  // Return the success code
+  return true;
+}
+
+// Reallocate '*ptr' to 'size' bytes
+// Return false if memory allocation failed, '*ptr' is then unchanged,
+// else return true
+bool CloudGraphRealloc(void **ptr, size_t size) {
+  void *mem = realloc(*ptr, size);
+  if (mem == NULL)
+    return false;
+  *ptr = mem;
+  return true;
+}
+
+// Free the memory used by the columns 'cols'
+void CloudGraphColumnsFree(CloudGraphColumns *cols) {
+  void *arrays[] = {cols->_node, cols->_id, cols->_family, cols->_x, 
+    cols->_y, cols->_rightX, cols->_rightY, cols->_theta, cols->_col, 
+    cols->_link, cols->_from, cols->_to, cols->_c1x, cols->_c1y, 
+    cols->_c2x, cols->_c2y};
+  for (int iArr = sizeof(arrays) / sizeof(void*); iArr--;)
+    if (arrays[iArr] != NULL)
+      free(arrays[iArr]);
+  memset(cols, 0, sizeof(CloudGraphColumns));
+}
+
+// Copy the geometry in the columns of 'cloud' to its nodes and links,
+// which gives the result of an arrangement to the callers
+// The links are copied using up to 'nbThread' threads
+void CloudGraphPushColumns(CloudGraph *cloud, int nbThread) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Loop on the nodes
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    CloudGraphNode *node = cols->_node[iNode];
+    node->_pos[0] = cols->_x[iNode];
+    node->_pos[1] = cols->_y[iNode];
+    node->_right[0] = cols->_rightX[iNode];
+    node->_right[1] = cols->_rightY[iNode];
+    node->_theta = cols->_theta[iNode];
+  }
+  // Copy the links, each thread on its own range of links
+  CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+  int nbTask = CloudGraphSplitRanges(cloud, NULL, nbThread, tasks);
+  CloudGraphRunTasks(CloudGraphPushLinksTask, tasks, nbTask);
+}
+
+// Copy the geometry of the link at position 'iLink' in the columns of
+// 'cloud' to the link
+void CloudGraphPushLink(CloudGraph *cloud, int iLink) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphLink *link = cols->_link[iLink];
+  int from = cols->_from[iLink];
+  int to = cols->_to[iLink];
+  if (from >= 0 && to >= 0) {
+    // Lazy links have no control points to update
+    if (link->_lazy == false) {
+      link->_ctrl[0][0] = cols->_x[from];
+      link->_ctrl[0][1] = cols->_y[from];
+      link->_ctrl[1][0] = cols->_c1x[iLink];
+      link->_ctrl[1][1] = cols->_c1y[iLink];
+      link->_ctrl[2][0] = cols->_c2x[iLink];
+      link->_ctrl[2][1] = cols->_c2y[iLink];
+      link->_ctrl[3][0] = cols->_x[to];
+      link->_ctrl[3][1] = cols->_y[to];
+    }
+    // Memorize the family of each node
+    link->_families[0] = cols->_family[from];
+    link->_families[1] = cols->_family[to];
+  }
+}
+
+// Copy the geometry of the nodes and links of 'cloud' to its columns,
+// after they are rebuilt or a layout is loaded from the cache
+void CloudGraphPullColumns(CloudGraph *cloud) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  // Loop on the nodes
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    CloudGraphNode *node = cols->_node[iNode];
+    cols->_x[iNode] = node->_pos[0];
+    cols->_y[iNode] = node->_pos[1];
+    cols->_rightX[iNode] = node->_right[0];
+    cols->_rightY[iNode] = node->_right[1];
+    cols->_theta[iNode] = node->_theta;
+  }
+  // Loop on the links, lazy links have no control points to copy 
+  // from, see CloudGraphEnsureColumns
+  for (int iLink = 0; iLink < cols->_nbLink; ++iLink) {
+    CloudGraphLink *link = cols->_link[iLink];
+    if (link->_lazy)
+      continue;
+    cols->_c1x[iLink] = link->_ctrl[1][0];
+    cols->_c1y[iLink] = link->_ctrl[1][1];
+    cols->_c2x[iLink] = link->_ctrl[2][0];
+    cols->_c2y[iLink] = link->_ctrl[2][1];
+  }
+}
+
+// Ensure the columns of 'cloud' reflect its nodes and links, rebuild 
+// them from the nodes and links if they have been modified
+// Return false if memory allocation failed, else return true
+bool CloudGraphEnsureColumns(CloudGraph *cloud) {
+  // If the columns are up to date
+  if (cloud->_cols._valid == true)
+    return true;
+  // Rebuild the columns
+  if (CloudGraphUpdateColumns(cloud) == false)
+    return false;
+  CloudGraphPullColumns(cloud);
+  // Set the control points of the lazy links from their nodes
+  CloudGraphColumns *cols = &(cloud->_cols);
+  for (int iLink = 0; iLink < cols->_nbLink; ++iLink)
+    if (cols->_link[iLink]->_lazy)
+      CloudGraphArrangeLink(cols, iLink, cols->_curvature);
+  return true;
+}
+
+// Get the number of nodes in the CloudGraph 'cloud'
+// Return 0 if arguments are invalid
+int CloudGraphGetNbNode(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return 0;
+  // Return the number of nodes
+  return cloud->_nodes->_nbElem;
+}
+
+// Get the number of links in the CloudGraph 'cloud'
+// Return 0 if arguments are invalid
+int CloudGraphGetNbLink(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return 0;
+  // Return the number of links
+  return cloud->_links->_nbElem;
+}
+
+// Get the position of the node 'id' into 'pos' (2 floats) and its 
+// right direction into 'right' (2 floats, may be NULL)
+// Return false if arguments are invalid, else return true
+bool CloudGraphGetNodeGeometry(CloudGraph *cloud, int id, float *pos, 
+  float *right) {
+  // Check arguments
+  if (cloud == NULL || pos == NULL || CloudGraphGetNode(cloud, id) == NULL)
+    return false;
+  // Ensure the columns are up to date
+  if (CloudGraphEnsureColumns(cloud) == false)
+    return false;
+  // Get the geometry from the columns
+  int iNode = cloud->_cols._col[id];
+  pos[0] = cloud->_cols._x[iNode];
+  pos[1] = cloud->_cols._y[iNode];
+  if (right != NULL) {
+    right[0] = cloud->_cols._rightX[iNode];
+    right[1] = cloud->_cols._rightY[iNode];
+  }
+  // Return the success code
+  return true;
+}
+
+// Set the flag defining if the links added to the CloudGraph 'cloud' 
+// from now on are lazy to 'lazy'
+// Do nothing if arguments are invalid
+void CloudGraphSetLazyLinks(CloudGraph *cloud, bool lazy) {
+  // Check arguments
+  if (cloud == NULL)
+    return;
+  cloud->_lazyLinks = lazy;
+}
+
+// Set the flag defining if the links of the CloudGraph 'cloud' 
+// between the same two nodes, in any direction, are bundled into one
+// link to 'bundle'
+// The links already in the CloudGraph are bundled when the flag is 
+// set, bundles stay as they are when it is unset
+// Return false if arguments are invalid or memory allocation failed,
+// in which case the flag is unchanged, else return true
+bool CloudGraphSetBundleLinks(CloudGraph *cloud, bool bundle) {
+  // Check arguments
+  if (cloud == NULL)
+    return false;
+  // If the links stop being bundled
+  if (bundle == false) {
+    // The set of links is not needed anymore
+    CloudGraphLinkSetFree(&(cloud->_linkSet));
+    cloud->_bundleLinks = false;
+    return true;
+  }
+  // If the links are already bundled
+  if (cloud->_bundleLinks)
+    // Nothing to do
+    return true;
+  // Create the new set of bundled links and reserve the set of links 
+  // for all the links
+  GSet *links = GSetCreate();
+  if (links == NULL || CloudGraphLinkSetReserve(&(cloud->_linkSet), 
+    cloud->_links->_nbElem) == false) {
+    if (links != NULL)
+      GSetFree(&links);
+    return false;
+  }
+  cloud->_bundleLinks = true;
+  // Loop on the links
+  GSetElem *ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    // If the link can be bundled into a previous link
+    if (CloudGraphAddToBundle(cloud, link->_nodes[0], link->_nodes[1],
+      link->_weight)) {
+      // The link is not needed anymore
+      if (CloudGraphArenaOwns(cloud, link) == false)
+        --(cloud->_nbOwned);
+      CloudGraphReleaseLink(cloud, &link);
+    } else {
+      // Keep the link
+      CloudGraphLinkSetInsert(&(cloud->_linkSet), link);
+      GSetAppend(links, link);
+      link->_elem = links->_tail;
+    }
+    ptr = ptr->_next;
+  }
+  // Replace the set of links
+  GSetFree(&(cloud->_links));
+  cloud->_links = links;
+  cloud->_cols._valid = false;
+  cloud->_adj._valid = false;
+  cloud->_dirty._tracked = false;
+  CloudGraphInvalidateViews(cloud);
+  // Return success code
+  return true;
+}
+
+// Rebuild the adjacency of 'cloud' from its links
+// The rows are in the order of the node IDs and full, the neighbors 
+// array has room after them for the rows which will grow
+// Return false if memory allocation failed, else return true
+bool CloudGraphUpdateAdjacency(CloudGraph *cloud) {
+  // Check arguments
+  if (cloud == NULL)
+    return false;
+  // Declare a pointer to the adjacency
+  CloudGraphAdjacency *adj = &(cloud->_adj);
+  adj->_valid = false;
+  // Ensure there is one row per node ID
+  int nbRow = cloud->_nodeIndexSize;
+  if (CloudGraphAdjacencyReserveRows(adj, nbRow) == false)
+    return false;
+  // Count the neighbors of each node, and the links toward unknown 
+  // nodes
+  memset(adj->_degree, 0, sizeof(int) * nbRow);
+  adj->_nbIgnored = 0;
+  int nbNeighbor = 0;
+  GSetElem *ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    if (CloudGraphGetNode(cloud, link->_nodes[0]) != NULL &&
+      CloudGraphGetNode(cloud, link->_nodes[1]) != NULL) {
+      ++(adj->_degree[link->_nodes[0]]);
+      ++(adj->_degree[link->_nodes[1]]);
+      nbNeighbor += 2;
+    } else {
+      ++(adj->_nbIgnored);
+    }
+    ptr = ptr->_next;
+  }
+  // Ensure the neighbors array is large enough, and allocated even if
+  // there is no neighbor so rows are never NULL
+  adj->_nbNeighbor = 0;
+  if (CloudGraphAdjacencyReserveNeighbors(adj, 
+    nbNeighbor + nbNeighbor / 2 + 1) == false)
+    return false;
+  // Set the offsets of the rows, each one having room for its 
+  // neighbors, and empty them
+  for (int iRow = 0; iRow < nbRow; ++iRow) {
+    adj->_offsets[iRow] = adj->_nbNeighbor;
+    adj->_room[iRow] = adj->_degree[iRow];
+    adj->_nbNeighbor += adj->_degree[iRow];
+    adj->_degree[iRow] = 0;
+  }
+  // Fill the rows
+  ptr = cloud->_links->_head;
+  while (ptr != NULL) {
+    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
+    if (CloudGraphGetNode(cloud, link->_nodes[0]) != NULL &&
+      CloudGraphGetNode(cloud, link->_nodes[1]) != NULL) {
+      for (int iNode = 2; iNode--;) {
+        int id = link->_nodes[iNode];
+        int iNeighbor = adj->_offsets[id] + (adj->_degree[id])++;
+        adj->_neighbors[iNeighbor] = link->_nodes[1 - iNode];
+        adj->_links[iNeighbor] = link;
+      }
+    }
+    ptr = ptr->_next;
+  }
+  adj->_nbRow = nbRow;
+  adj->_valid = true;
+  // Return the success code
+  return true;
+}
+
+// Ensure the adjacency of 'cloud' reflects its nodes and links, 
+// rebuild it if it couldn't be kept up to date
+// Return false if memory allocation failed, else return true
+bool CloudGraphEnsureAdjacency(CloudGraph *cloud) {
+  // If the adjacency is up to date
+  if (cloud->_adj._valid == true)
+    return true;
+  // Rebuild the adjacency
+  return CloudGraphUpdateAdjacency(cloud);
+}
+
+// Ensure the adjacency 'adj' has room for 'nb' rows
+// Return false if memory allocation failed, else return true
+bool CloudGraphAdjacencyReserveRows(CloudGraphAdjacency *adj, int nb) {
+  // If there is enough room
+  if (nb <= adj->_capacityRow)
+    return true;
+  // Double the capacity, or more if needed
+  int capacity = (adj->_capacityRow < INT_MAX / 2 ? 
+    2 * adj->_capacityRow : INT_MAX);
+  if (capacity < nb)
+    capacity = nb;
+  if (CloudGraphRealloc((void**)&(adj->_offsets), 
+    sizeof(int) * capacity) == false ||
+    CloudGraphRealloc((void**)&(adj->_degree), 
+    sizeof(int) * capacity) == false ||
+    CloudGraphRealloc((void**)&(adj->_room), 
+    sizeof(int) * capacity) == false)
+    return false;
+  adj->_capacityRow = capacity;
+  // Return the success code
+  return true;
+}
+
+// Ensure the adjacency 'adj' has room for 'nb' more neighbors after 
+// its last row
+// Return false if memory allocation failed, else return true
+bool CloudGraphAdjacencyReserveNeighbors(CloudGraphAdjacency *adj, 
+  int nb) {
+  // If the neighbors can't be indexed
+  if (nb > INT_MAX - adj->_nbNeighbor)
+    return false;
+  // If there is enough room
+  if (adj->_nbNeighbor + nb <= adj->_capacityNeighbor)
+    return true;
+  // Double the capacity, or more if needed
+  int capacity = (adj->_capacityNeighbor < INT_MAX / 2 ? 
+    2 * adj->_capacityNeighbor : INT_MAX);
+  if (capacity < adj->_nbNeighbor + nb)
+    capacity = adj->_nbNeighbor + nb;
+  if (CloudGraphRealloc((void**)&(adj->_neighbors), 
+    sizeof(int) * capacity) == false ||
+    CloudGraphRealloc((void**)&(adj->_links), 
+    sizeof(CloudGraphLink*) * capacity) == false)
+    return false;
+  adj->_capacityNeighbor = capacity;
+  // Return the success code
+  return true;
+}
+
+// Add the link 'link', just added to 'cloud', to the rows of its nodes
+// in the adjacency of 'cloud' if it is up to date
+// A full row is moved after the last row with twice its room, so the
+// cost is O(1) amortized
+void CloudGraphAdjacencyAddLink(CloudGraph *cloud, CloudGraphLink *link) {
+  // Declare a pointer to the adjacency
+  CloudGraphAdjacency *adj = &(cloud->_adj);
+  // If the adjacency is not up to date, it will be rebuilt
+  if (adj->_valid == false)
+    return;
+  // If the link is toward an unknown node it is ignored
+  if (CloudGraphGetNode(cloud, link->_nodes[0]) == NULL ||
+    CloudGraphGetNode(cloud, link->_nodes[1]) == NULL) {
+    ++(adj->_nbIgnored);
+    return;
+  }
+  // Loop on the rows of the nodes of the link
+  for (int iNode = 2; iNode--;) {
+    int id = link->_nodes[iNode];
+    // If the row is full, move it after the last row
+    if (adj->_degree[id] == adj->_room[id]) {
+      int room = 2 * adj->_room[id] + 1;
+      if (CloudGraphAdjacencyReserveNeighbors(adj, room) == false) {
+        // The adjacency will be rebuilt
+        adj->_valid = false;
+        return;
+      }
+      memcpy(adj->_neighbors + adj->_nbNeighbor, 
+        adj->_neighbors + adj->_offsets[id], 
+        sizeof(int) * adj->_degree[id]);
+      memcpy(adj->_links + adj->_nbNeighbor, 
+        adj->_links + adj->_offsets[id], 
+        sizeof(CloudGraphLink*) * adj->_degree[id]);
+      adj->_offsets[id] = adj->_nbNeighbor;
+      adj->_room[id] = room;
+      adj->_nbNeighbor += room;
+    }
+    // Append the other node of the link to the row
+    int iNeighbor = adj->_offsets[id] + (adj->_degree[id])++;
+    adj->_neighbors[iNeighbor] = link->_nodes[1 - iNode];
+    adj->_links[iNeighbor] = link;
+  }
+}
+
+// Add the row of the node 'id', just added to 'cloud', to the 
+// adjacency of 'cloud' if it is up to date
+void CloudGraphAdjacencyAddNode(CloudGraph *cloud, int id) {
+  // Declare a pointer to the adjacency
+  CloudGraphAdjacency *adj = &(cloud->_adj);
+  // If the adjacency is not up to date, it will be rebuilt
+  if (adj->_valid == false)
+    return;
+  // If some links are toward unknown nodes, they may be toward this 
+  // one, rebuild the adjacency
+  if (adj->_nbIgnored > 0) {
+    adj->_valid = false;
+    return;
+  }
+  // Add empty rows up to the one of the node
+  if (id < adj->_nbRow)
+    return;
+  if (CloudGraphAdjacencyReserveRows(adj, id + 1) == false) {
+    adj->_valid = false;
+    return;
+  }
+  for (int iRow = adj->_nbRow; iRow <= id; ++iRow) {
+    adj->_offsets[iRow] = adj->_nbNeighbor;
+    adj->_degree[iRow] = 0;
+    adj->_room[iRow] = 0;
+  }
+  adj->_nbRow = id + 1;
+}
+
+// Remove the link 'link' from the rows of its nodes in the adjacency 
+// of 'cloud' if it is up to date
+// The link is replaced by the last neighbor of each row, in 
+// O(degree of its nodes)
+void CloudGraphAdjacencyRemoveLink(CloudGraph *cloud, 
+  CloudGraphLink *link) {
+  // Declare a pointer to the adjacency
+  CloudGraphAdjacency *adj = &(cloud->_adj);
+  // If the adjacency is not up to date, it will be rebuilt
+  if (adj->_valid == false)
+    return;
+  // If the link is toward an unknown node, it is not in the adjacency
+  if (CloudGraphGetNode(cloud, link->_nodes[0]) == NULL ||
+    CloudGraphGetNode(cloud, link->_nodes[1]) == NULL) {
+    --(adj->_nbIgnored);
+    return;
+  }
+  // Loop on the rows of the nodes of the link
+  for (int iNode = 2; iNode--;) {
+    int id = link->_nodes[iNode];
+    int first = adj->_offsets[id];
+    int last = first + adj->_degree[id] - 1;
+    int iNeighbor = first;
+    while (iNeighbor <= last && adj->_links[iNeighbor] != link)
+      ++iNeighbor;
+    // If the link is not in the row, the adjacency will be rebuilt
+    if (iNeighbor > last) {
+      adj->_valid = false;
+      return;
+    }
+    // Move the last neighbor of the row in place of the link
+    adj->_neighbors[iNeighbor] = adj->_neighbors[last];
+    adj->_links[iNeighbor] = adj->_links[last];
+    --(adj->_degree[id]);
+  }
+}
+
+// Free the memory used by the adjacency 'adj'
+void CloudGraphAdjacencyFree(CloudGraphAdjacency *adj) {
+  if (adj->_offsets != NULL)
+    free(adj->_offsets);
+  if (adj->_degree != NULL)
+    free(adj->_degree);
+  if (adj->_room != NULL)
+    free(adj->_room);
+  if (adj->_neighbors != NULL)
+    free(adj->_neighbors);
+  if (adj->_links != NULL)
+    free(adj->_links);
+  memset(adj, 0, sizeof(CloudGraphAdjacency));
+}
+
+// Get the number of links between the node 'id' and other existing 
+// nodes of the CloudGraph 'cloud'
+// The adjacency is rebuilt in O(nb nodes + nb links) if nodes or links
+// have been added since the last query, else the lookup is O(1)
+// Return 0 if arguments are invalid or memory allocation failed
+int CloudGraphGetDegree(CloudGraph *cloud, int id) {
+  // Get the neighbors
+  int nb = 0;
+  CloudGraphGetNeighbors(cloud, id, &nb);
+  // Return the degree
+  return nb;
+}
+
+// Get the IDs of the neighbors of the node 'id', their number is set
+// into 'nb'
+// The returned array belongs to the CloudGraph and is valid until 
+// nodes or links are added or removed
+// The adjacency is rebuilt as in CloudGraphGetDegree
+// Return NULL if arguments are invalid or memory allocation failed
+const int* CloudGraphGetNeighbors(CloudGraph *cloud, int id, int *nb) {
+  // Check arguments
+  if (nb == NULL)
+    return NULL;
+  *nb = 0;
+  if (CloudGraphGetNode(cloud, id) == NULL)
+    return NULL;
+  // Ensure the adjacency is up to date
+  if (CloudGraphEnsureAdjacency(cloud) == false)
+    return NULL;
+  // Get the row of the node
+  const CloudGraphAdjacency *adj = &(cloud->_adj);
+  *nb = adj->_degree[id];
+  return adj->_neighbors + adj->_offsets[id];
+}
+
+// Set the iterator 'iter' on the neighbors of the node 'id'
+// The iterator is valid until nodes or links are added or removed
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphNeighborIterInit(CloudGraph *cloud, int id, 
+  CloudGraphNeighborIter *iter) {
+  // Check arguments
+  if (iter == NULL)
+    return false;
+  // Get the neighbors
+  int nb = 0;
+  const int *neighbors = CloudGraphGetNeighbors(cloud, id, &nb);
+  if (neighbors == NULL) {
+    iter->_cur = iter->_end = NULL;
+    return false;
+  }
+  // Set the iterator
+  iter->_cur = neighbors;
+  iter->_end = neighbors + nb;
+  // Return the success code
+  return true;
+}
+
+// Get the ID of the next neighbor of the iterator 'iter' into 'id'
+// Return false if there is no more neighbor or arguments are invalid,
+// else return true
+bool CloudGraphNeighborIterNext(CloudGraphNeighborIter *iter, int *id) {
+  // Check arguments
+  if (iter == NULL || id == NULL || iter->_cur == iter->_end)
+    return false;
+  // Get the next neighbor
+  *id = *((iter->_cur)++);
+  return true;
+}
+
+// Get a TGA picture representing the CloudGraph using the graphical
+// options 'opt'
+// Return NULL if we couldn't create the TGA or if it would be larger
+// than CLOUDGRAPH_MAXCANVAS
+TGA* CloudGraphToTGA(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL)
+    return NULL;
+  // Render the whole CloudGraph, one pixel per unit
+  CloudGraphView view;
+  if (CloudGraphGetView(cloud, 1.0, &view) == false)
+    return NULL;
+  return CloudGraphToTGAView(cloud, opt, &view);
+}
+
+// Get into 'view' the view of the whole CloudGraph 'cloud' at 'scale'
+// pixels per unit, ensuring the nodes and links are ready to be 
+// rendered by CloudGraphToTGAView
+// Return false if arguments are invalid, if memory allocation failed 
+// or if the TGA would be larger than CLOUDGRAPH_MAXCANVAS, else return
+// true
+bool CloudGraphGetView(CloudGraph *cloud, float scale, 
+  CloudGraphView *view) {
+  // Check arguments
+  if (cloud == NULL || view == NULL || scale <= 0.0)
+    return false;
+  // Ensure the columns reflect the nodes and links
+  if (CloudGraphEnsureColumns(cloud) == false)
+    return false;
+  // If the bounding box is too large for the dimensions of a tga
+  for (int iDim = 2; iDim--;)
+    if (VecGet(cloud->_boundingBox->_axis[iDim], iDim) * scale > 
+      CLOUDGRAPH_MAXCANVAS)
+      return false;
+  // Set the view on the bounding box
+  for (int iDim = 2; iDim--;) {
+    view->_origin[iDim] = VecGet(cloud->_boundingBox->_pos, iDim);
+    view->_dim[iDim] = (int)floor(
+      VecGet(cloud->_boundingBox->_axis[iDim], iDim) * scale);
+  }
+  view->_scale = scale;
+  view->_generation = cloud->_generation;
+  return true;
+}
+
+// Mark the views of 'cloud' obtained with CloudGraphGetView before a 
+// change of its nodes, families, links or arrangement as out of date,
+// CloudGraphToTGAView refuses to render them
+void CloudGraphInvalidateViews(CloudGraph *cloud) {
+  // Count one more change, the views remember the count when they are
+  // obtained
+  ++(cloud->_generation);
+}
+
+// Get a TGA picture representing the part 'view' of the CloudGraph 
+// using the graphical options 'opt'
+// The CloudGraph is not modified, several views of the same 
+// CloudGraph can be rendered at the same time
+// Return NULL if arguments are invalid, if the CloudGraph has been 
+// modified or arranged by the CloudGraph functions since 'view' was 
+// obtained with CloudGraphGetView, or if we couldn't create the TGA
+TGA* CloudGraphToTGAView(const CloudGraph *cloud, 
+  const CloudGraphOpt *opt, const CloudGraphView *view) {
+  // Check arguments
+  if (cloud == NULL || opt == NULL || view == NULL || 
+    view->_scale <= 0.0 || view->_dim[0] < 0 || view->_dim[1] < 0 ||
+    view->_dim[0] > CLOUDGRAPH_MAXCANVAS || 
+    view->_dim[1] > CLOUDGRAPH_MAXCANVAS)
+    return NULL;
+  // The CloudGraph must not have changed since the view was obtained
+  if (cloud->_cols._valid == false || 
+    view->_generation != cloud->_generation)
+    return NULL;
+  // Declare a variable to memorize the dimensions of the tga
+  VecShort *dim = VecShortCreate(2);
+  // Create a pixel for the background
+  TGAPixel *pixel = TGAGetWhitePixel();
+  // If we couldn't allocate memory
+  if (dim == NULL || pixel == NULL) {
+    // Free memory and stop here
+    VecFree(&dim);
+    TGAPixelFree(&pixel);
+    return NULL;
+  }
+  // Set the dimension of the tga
+  for (int i = 2; i--;)
+    VecSet(dim, i, (short)(view->_dim[i]));
+  // Create the TGA
+  TGA *tga = TGACreate(dim, pixel);
+  // Prepare the rendering
+  CloudGraphRender render;
+  render._background = pixel;
+  if (tga == NULL || 
+    CloudGraphRenderInit(&render, cloud, opt, tga, view) == false) {
+    // Free memory and stop here
+    if (tga != NULL) {
+      TGAFree(&tga);
+      CloudGraphRenderFree(&render);
+    }
+    VecFree(&dim);
+    TGAPixelFree(&pixel);
+    return NULL;
+  }
+  // Render the tiles, each thread on every nbTask-th tile
+  int nbTile = render._nbTile[0] * render._nbTile[1];
+  int nbTask = opt->_nbThread;
+  if (nbTask > nbTile)
+    nbTask = nbTile;
+  if (nbTask > CLOUDGRAPH_MAXTHREAD)
+    nbTask = CLOUDGRAPH_MAXTHREAD;
+  if (nbTask < 1)
+    nbTask = 1;
+  CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+  for (int iTask = 0; iTask < nbTask; ++iTask) {
+    tasks[iTask]._cloud = NULL;
+    tasks[iTask]._opt = NULL;
+    tasks[iTask]._render = &render;
+    tasks[iTask]._firstTile = iTask;
+    tasks[iTask]._stepTile = nbTask;
+  }
+  // In density mode, get the greatest number of links on a pixel, each
+  // thread on its own tiles, to tone map the tiles the same way
+  render._maxCount = 0;
+  if (opt->_linkRenderMode != CloudGraphOptLinkRenderCurve) {
+    CloudGraphRunTasks(CloudGraphDensityTask, tasks, nbTask);
+    for (int iTask = 0; iTask < nbTask; ++iTask) {
+      if (tasks[iTask]._success == false) {
+        TGAFree(&tga);
+        CloudGraphRenderFree(&render);
+        TGAPixelFree(&pixel);
+        VecFree(&dim);
+        return NULL;
+      }
+      if (tasks[iTask]._maxCount > render._maxCount)
+        render._maxCount = tasks[iTask]._maxCount;
+    }
+  }
+  CloudGraphRunTasks(CloudGraphRenderTask, tasks, nbTask);
+  // If a tile couldn't be rendered, the TGA is incomplete
+  for (int iTask = 0; iTask < nbTask; ++iTask)
+    if (tasks[iTask]._success == false)
+      TGAFree(&tga);
+  // Free memory
+  CloudGraphRenderFree(&render);
+  TGAPixelFree(&pixel);
+  VecFree(&dim);
+  // Return the TGA
+  return tga;
+}
+
+// Create a font for the labels of a CloudGraph
+// Return NULL if we couldn't create the font
+TGAFont* CloudGraphCreateFont(void) {
+  TGAFont *font = TGAFontCreate(tgaFontDefault);
+  if (font == NULL)
+    return NULL;
+  // Set the font anchor 
+  TGAFontSetAnchor(font, tgaFontAnchorCenterLeft);
+  // Set the font scale
+  VecFloat *v = VecFloatCreate(2);
+  if (v != NULL) {
+    VecSet(v, 0, 0.5); VecSet(v, 1, 1.0);
+    TGAFontSetScale(font, v); 
+    VecFree(&v);
+  }
+  return font;
+}
+
+// Prepare the rendering 'render' of the part 'view' of 'cloud' with 
+// 'opt' into 'tga': the colors of the pencil and the elements drawn 
+// on each tile
+// The colors of the pencil are those it would have if all the 
+// elements were drawn in order, a link whose node has no family keeps
+// the color of the previous link
+// Return false if memory allocation failed, else return true
+bool CloudGraphRenderInit(CloudGraphRender *render, 
+  const CloudGraph *cloud, const CloudGraphOpt *opt, TGA *tga, 
+  const CloudGraphView *view) {
+  // Declare a pointer to the columns
+  const CloudGraphColumns *cols = &(cloud->_cols);
+  // Set the properties of the rendering
+  render->_cloud = cloud;
+  render->_opt = opt;
+  render->_view = *view;
+  render->_tga = tga;
+  for (int iDim = 2; iDim--;) {
+    render->_sizeTile[iDim] = (opt->_tiledRender ? 
+      CLOUDGRAPH_TILESIZE : render->_view._dim[iDim]);
+    if (render->_sizeTile[iDim] < 1)
+      render->_sizeTile[iDim] = 1;
+    render->_nbTile[iDim] = 
+      (render->_view._dim[iDim] + render->_sizeTile[iDim] - 1) /
+      render->_sizeTile[iDim];
+    if (render->_nbTile[iDim] < 1)
+      render->_nbTile[iDim] = 1;
+  }
+  render->_nbNode = cols->_nbNode;
+  render->_nbLink = cols->_nbLink;
+  render->_nbFamily = cloud->_families->_nbElem;
+  int nbTile = render->_nbTile[0] * render->_nbTile[1];
+  int nbFamilyId = cloud->_familyIndexSize;
+  // Allocate memory
+  render->_families = (CloudGraphFamily**)malloc(
+    sizeof(CloudGraphFamily*) * (render->_nbFamily + 1));
+  render->_emptyFamily = 
+    (bool*)malloc(sizeof(bool) * (nbFamilyId > 0 ? nbFamilyId : 1));
+  render->_linkRgba = 
+    (unsigned char*)malloc(8 * (size_t)(render->_nbLink + 1));
+  render->_linkRgbaSet = 
+    (unsigned char*)malloc((size_t)(render->_nbLink + 1));
+  render->_offsets = (int*)malloc(sizeof(int) * (nbTile + 1));
+  render->_cursor = (int*)malloc(sizeof(int) * nbTile);
+  render->_mark = (int*)malloc(sizeof(int) * nbTile);
+  render->_elems = NULL;
+  render->_sprites = NULL;
+  if (render->_families == NULL || render->_emptyFamily == NULL || 
+    render->_linkRgba == NULL || render->_linkRgbaSet == NULL || 
+    render->_offsets == NULL || render->_cursor == NULL || 
+    render->_mark == NULL)
+    return false;
+  // Get the families in the order of their list
+  GSetElem *ptr = cloud->_families->_head;
+  for (int iFamily = 0; ptr != NULL; ++iFamily, ptr = ptr->_next)
+    render->_families[iFamily] = (CloudGraphFamily*)(ptr->_data);
+  // Set the family to empty by default
+  for (int iFamily = nbFamilyId; iFamily--;)
+    render->_emptyFamily[iFamily] = true;
+  // Declare variables to follow the colors of the pencil
+  unsigned char rgba[8];
+  unsigned char rgbaSet = 0;
+  // Loop on the nodes, the color 0 of the pencil is the one of the 
+  // family of the last node drawn
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    CloudGraphFamily *family = 
+      CloudGraphGetFamily(cloud, cols->_family[iNode]);
+    if (family != NULL) {
+      render->_emptyFamily[cols->_family[iNode]] = false;
+      memcpy(rgba, family->_rgba, 4);
+      rgbaSet |= 1;
+    }
+  }
+  // Get the greatest weight of the links for their opacity
+  int maxWeight = 1;
+  if (opt->_linkWeightMode == CloudGraphOptLinkWeightOpacity)
+    for (int iLink = 0; iLink < cols->_nbLink; ++iLink)
+      if (cols->_link[iLink]->_weight > maxWeight)
+        maxWeight = cols->_link[iLink]->_weight;
+  // Loop on the links
+  for (int iLink = 0; iLink < cols->_nbLink; ++iLink) {
+    CloudGraphLink *link = cols->_link[iLink];
+    // Set the colors, the opacity is proportional to the weight of the
+    // link in opacity mode
+    for (int iNode = 2; iNode--;) {
+      CloudGraphFamily *family = 
+        CloudGraphGetFamily(cloud, link->_families[iNode]);
+      if (family != NULL) {
+        memcpy(rgba + 4 * iNode, family->_rgba, 4);
+        if (opt->_linkWeightMode == CloudGraphOptLinkWeightOpacity) {
+          float alpha = (float)(family->_rgba[3]) * 
+            (float)(link->_weight) / (float)maxWeight;
+          rgba[4 * iNode + 3] = (unsigned char)(
+            alpha > CLOUDGRAPH_MINLINKALPHA ? 
+            alpha : CLOUDGRAPH_MINLINKALPHA);
+        }
+        rgbaSet |= (1 << iNode);
+      }
+    }
+    memcpy(render->_linkRgba + 8 * (size_t)iLink, rgba, 8);
+    render->_linkRgbaSet[iLink] = rgbaSet;
+  }
+  // The labels of the families are drawn with the thickness of the 
+  // last link
+  render->_familyThickness = 2.0;
+  if (opt->_linkWeightMode == CloudGraphOptLinkWeightThickness &&
+    cols->_nbLink > 0)
+    render->_familyThickness = 2.0 * (1.0 + 
+      log2((float)(cols->_link[cols->_nbLink - 1]->_weight)));
+  // Count the elements of each tile
+  int nbElem = render->_nbNode + render->_nbLink + render->_nbFamily;
+  for (int iTile = nbTile; iTile--;) {
+    render->_offsets[iTile + 1] = 0;
+    render->_mark[iTile] = -1;
+  }
+  for (int iElem = 0; iElem < nbElem; ++iElem)
+    CloudGraphBinElem(render, iElem, false);
+  // Get the position of the first element of each tile
+  render->_offsets[0] = 0;
+  for (int iTile = 0; iTile < nbTile; ++iTile) {
+    if (render->_offsets[iTile + 1] > INT_MAX - render->_offsets[iTile])
+      return false;
+    render->_offsets[iTile + 1] += render->_offsets[iTile];
+    render->_cursor[iTile] = render->_offsets[iTile];
+    render->_mark[iTile] = -1;
+  }
+  // Fill the elements of each tile
+  render->_elems = 
+    (int*)malloc(sizeof(int) * (render->_offsets[nbTile] + 1));
+  if (render->_elems == NULL)
+    return false;
+  for (int iElem = 0; iElem < nbElem; ++iElem)
+    CloudGraphBinElem(render, iElem, true);
+  // Rasterize the disc of the nodes
+  if (opt->_nodeSprite && CloudGraphRenderSprites(render) == false)
+    return false;
+  return true;
+}
+
+// Free the memory used by the rendering 'render'
+void CloudGraphRenderFree(CloudGraphRender *render) {
+  if (render->_families != NULL)
+    free(render->_families);
+  if (render->_emptyFamily != NULL)
+    free(render->_emptyFamily);
+  if (render->_linkRgba != NULL)
+    free(render->_linkRgba);
+  if (render->_linkRgbaSet != NULL)
+    free(render->_linkRgbaSet);
+  if (render->_offsets != NULL)
+    free(render->_offsets);
+  if (render->_cursor != NULL)
+    free(render->_cursor);
+  if (render->_mark != NULL)
+    free(render->_mark);
+  if (render->_elems != NULL)
+    free(render->_elems);
+  if (render->_sprites != NULL) {
+    for (int iSprite = 
+      CLOUDGRAPH_SPRITEPHASE * CLOUDGRAPH_SPRITEPHASE; iSprite--;)
+      if (render->_sprites[iSprite]._mask != NULL)
+        free(render->_sprites[iSprite]._mask);
+    free(render->_sprites);
+  }
+}
+
+// Get into 'pix' the position in the TGA of the point ('x', 'y') of 
+// the CloudGraph seen through 'view'
+void CloudGraphViewPoint(const CloudGraphView *view, float x, float y,
+  float *pix) {
+  pix[0] = (x - view->_origin[0]) * view->_scale;
+  pix[1] = (y - view->_origin[1]) * view->_scale;
+}
+
+// Add the element 'iElem' of the rendering 'render' to the tiles it 
+// is drawn on, counting them if 'fill' is false, else filling them
+// The tiles of the nodes and labels are those of their bounding box, 
+// the tiles of the links are those crossed by their curve
+void CloudGraphBinElem(CloudGraphRender *render, int iElem, bool fill) {
+  const CloudGraph *cloud = render->_cloud;
+  const CloudGraphOpt *opt = render->_opt;
+  const CloudGraphColumns *cols = &(cloud->_cols);
+  const CloudGraphView *view = &(render->_view);
+  // Size of the font in the TGA
+  float fontSize = opt->_fontSizeNode * view->_scale;
+  float min[2];
+  float max[2];
+  // If the element is a node
+  if (iElem < render->_nbNode) {
+    int iNode = iElem;
+    // Nodes without family are not drawn
+    if (CloudGraphGetFamily(cloud, cols->_family[iNode]) == NULL)
+      return;
+    // Add the node, its size plus the antialiasing
+    float margin = 0.5 * fontSize + 2.0;
+    float pix[2];
+    CloudGraphViewPoint(view, cols->_x[iNode], cols->_y[iNode], pix);
+    for (int iDim = 2; iDim--;) {
+      min[iDim] = pix[iDim] - margin;
+      max[iDim] = pix[iDim] + margin;
+    }
+    // Add the label, its bounding box is at the anchor of the string,
+    // it is extended by the size of the font on each side
+    if (opt->_nodeLabelMode == CloudGraphOptNodeLabelAll) {
+      CloudGraphNode *node = cols->_node[iNode];
+      float minLbl[2] = {FLT_MAX, FLT_MAX};
+      float maxLbl[2] = {-FLT_MAX, -FLT_MAX};
+      CloudGraphExtendBounds(&(node->_boundingBoxLbl), minLbl, maxLbl);
+      CloudGraphViewPoint(view, minLbl[0], minLbl[1], minLbl);
+      CloudGraphViewPoint(view, maxLbl[0], maxLbl[1], maxLbl);
+      for (int iDim = 2; iDim--;) {
+        minLbl[iDim] -= fontSize;
+        maxLbl[iDim] += fontSize;
+        if (minLbl[iDim] < min[iDim])
+          min[iDim] = minLbl[iDim];
+        if (maxLbl[iDim] > max[iDim])
+          max[iDim] = maxLbl[iDim];
+      }
+    }
+    CloudGraphBinRect(render, iElem, min, max, fill);
+  // Else, if the element is a link
+  } else if (iElem < render->_nbNode + render->_nbLink) {
+    int iLink = iElem - render->_nbNode;
+    float ctrl[8];
+    if (CloudGraphGetRenderCurve(render, iLink, ctrl) == false)
+      return;
+    // Add the curve, with half its thickness plus the antialiasing
+    float margin = view->_scale + 2.0;
+    if (opt->_linkWeightMode == CloudGraphOptLinkWeightThickness)
+      margin = view->_scale * 
+        (1.0 + log2((float)(cols->_link[iLink]->_weight))) + 2.0;
+    CloudGraphBinCurve(render, iElem, ctrl, margin, 
+      CLOUDGRAPH_RENDERSPLITDEPTH, fill);
+  // Else the element is the label of a family
+  } else {
+    CloudGraphFamily *family = 
+      render->_families[iElem - render->_nbNode - render->_nbLink];
+    // Labels of empty families are not drawn
+    if (opt->_familyLabelMode != CloudGraphOptFamilyLabelAll ||
+      family->_id < 0 || family->_id >= cloud->_familyIndexSize ||
+      render->_emptyFamily[family->_id])
+      return;
+    // Add the label, extended by the size of the font on each side
+    for (int iDim = 2; iDim--;) {
+      min[iDim] = FLT_MAX;
+      max[iDim] = -FLT_MAX;
+    }
+    CloudGraphExtendBounds(&(family->_boundingBox), min, max);
+    CloudGraphViewPoint(view, min[0], min[1], min);
+    CloudGraphViewPoint(view, max[0], max[1], max);
+    for (int iDim = 2; iDim--;) {
+      min[iDim] -= fontSize;
+      max[iDim] += fontSize;
+    }
+    CloudGraphBinRect(render, iElem, min, max, fill);
+  }
+}
+
+// Add the element 'iElem' of the rendering 'render' to the tiles 
+// overlapping the rectangle 'min', 'max' in the TGA
+// An element already added to a tile is not added again
+void CloudGraphBinRect(CloudGraphRender *render, int iElem, 
+  const float *min, const float *max, bool fill) {
+  // Get the range of tiles, nothing to do if the rectangle is outside
+  // the TGA
+  int first[2];
+  int last[2];
+  for (int iDim = 2; iDim--;) {
+    if (max[iDim] < 0.0 || min[iDim] >= (float)(render->_view._dim[iDim]))
+      return;
+    first[iDim] = (min[iDim] <= 0.0 ? 0 : 
+      (int)(min[iDim] / (float)(render->_sizeTile[iDim])));
+    last[iDim] = (max[iDim] >= (float)(render->_view._dim[iDim]) ? 
+      render->_nbTile[iDim] - 1 : 
+      (int)(max[iDim] / (float)(render->_sizeTile[iDim])));
+    if (last[iDim] >= render->_nbTile[iDim])
+      last[iDim] = render->_nbTile[iDim] - 1;
+  }
+  // Loop on the tiles
+  for (int y = first[1]; y <= last[1]; ++y) {
+    for (int x = first[0]; x <= last[0]; ++x) {
+      int iTile = y * render->_nbTile[0] + x;
+      if (render->_mark[iTile] == iElem)
+        continue;
+      render->_mark[iTile] = iElem;
+      if (fill)
+        render->_elems[(render->_cursor[iTile])++] = iElem;
+      else
+        ++(render->_offsets[iTile + 1]);
+    }
+  }
+}
+
+// Add the element 'iElem' of the rendering 'render' to the tiles 
+// crossed by the curve of control points 'ctrl' in the TGA, drawn 
+// 'margin' pixels thick, splitting the curve up to 'depth' times
+// The curve is inside the convex hull of its control points, it is 
+// split in halves until the hull is in one tile, so a long link is 
+// added to the tiles along it instead of all the tiles of its 
+// bounding box
+void CloudGraphBinCurve(CloudGraphRender *render, int iElem, 
+  const float *ctrl, float margin, int depth, bool fill) {
+  // Get the bounds of the control points
+  float min[2];
+  float max[2];
+  for (int iDim = 2; iDim--;) {
+    min[iDim] = max[iDim] = ctrl[iDim];
+    for (int iCtrl = 1; iCtrl < 4; ++iCtrl) {
+      if (ctrl[2 * iCtrl + iDim] < min[iDim])
+        min[iDim] = ctrl[2 * iCtrl + iDim];
+      if (ctrl[2 * iCtrl + iDim] > max[iDim])
+        max[iDim] = ctrl[2 * iCtrl + iDim];
+    }
+    min[iDim] -= margin;
+    max[iDim] += margin;
+    // If the curve is outside the TGA, nothing to do
+    if (max[iDim] < 0.0 || min[iDim] >= (float)(render->_view._dim[iDim]))
+      return;
+  }
+  // If the bounds are in one tile or the curve can't be split anymore
+  if (depth == 0 || 
+    ((int)floor(min[0] / render->_sizeTile[0]) == 
+      (int)floor(max[0] / render->_sizeTile[0]) &&
+    (int)floor(min[1] / render->_sizeTile[1]) == 
+      (int)floor(max[1] / render->_sizeTile[1]))) {
+    CloudGraphBinRect(render, iElem, min, max, fill);
+    return;
+  }
+  // Split the curve in halves with the de Casteljau algorithm
+  float left[8];
+  float right[8];
+  for (int iDim = 2; iDim--;) {
+    float p01 = 0.5 * (ctrl[iDim] + ctrl[2 + iDim]);
+    float p12 = 0.5 * (ctrl[2 + iDim] + ctrl[4 + iDim]);
+    float p23 = 0.5 * (ctrl[4 + iDim] + ctrl[6 + iDim]);
+    float p012 = 0.5 * (p01 + p12);
+    float p123 = 0.5 * (p12 + p23);
+    float p0123 = 0.5 * (p012 + p123);
+    left[iDim] = ctrl[iDim];
+    left[2 + iDim] = p01;
+    left[4 + iDim] = p012;
+    left[6 + iDim] = p0123;
+    right[iDim] = p0123;
+    right[2 + iDim] = p123;
+    right[4 + iDim] = p23;
+    right[6 + iDim] = ctrl[6 + iDim];
+  }
+  CloudGraphBinCurve(render, iElem, left, margin, depth - 1, fill);
+  CloudGraphBinCurve(render, iElem, right, margin, depth - 1, fill);
+}
+
+// Get the control points of the link 'iLink' of the rendering 
+// 'render', in the TGA, into 'ctrl' (4 points, x and y interleaved)
+// Return false if the link is not drawn, else return true
+bool CloudGraphGetRenderCurve(const CloudGraphRender *render, int iLink, 
+  float *ctrl) {
+  const CloudGraphColumns *cols = &(render->_cloud->_cols);
+  const CloudGraphLink *link = cols->_link[iLink];
+  // If the link is lazy, its control points are in the columns
+  if (link->_lazy) {
+    int from = cols->_from[iLink];
+    int to = cols->_to[iLink];
+    if (from < 0 || to < 0)
+      return false;
+    CloudGraphViewPoint(&(render->_view), 
+      cols->_x[from], cols->_y[from], ctrl);
+    CloudGraphViewPoint(&(render->_view), 
+      cols->_c1x[iLink], cols->_c1y[iLink], ctrl + 2);
+    CloudGraphViewPoint(&(render->_view), 
+      cols->_c2x[iLink], cols->_c2y[iLink], ctrl + 4);
+    CloudGraphViewPoint(&(render->_view), 
+      cols->_x[to], cols->_y[to], ctrl + 6);
+  // Else they are in the link
+  } else {
+    for (int iCtrl = 4; iCtrl--;)
+      CloudGraphViewPoint(&(render->_view), link->_ctrl[iCtrl][0], 
+        link->_ctrl[iCtrl][1], ctrl + 2 * iCtrl);
+  }
+  return true;
+}
+
+// Get the position 'origin' and dimensions 'size' in the TGA of the 
+// tile 'iTile' of the rendering 'render'
+void CloudGraphGetTile(const CloudGraphRender *render, int iTile, 
+  int *origin, int *size) {
+  origin[0] = (iTile % render->_nbTile[0]) * render->_sizeTile[0];
+  origin[1] = (iTile / render->_nbTile[0]) * render->_sizeTile[1];
+  for (int iDim = 2; iDim--;) {
+    size[iDim] = render->_view._dim[iDim] - origin[iDim];
+    if (size[iDim] > render->_sizeTile[iDim])
+      size[iDim] = render->_sizeTile[iDim];
+  }
+}
+
+// Thread function rendering the tiles of a task
+// Each tile is drawn in its own TGA with the elements overlapping it,
+// in the order of the elements, and then copied in the rendered TGA
+// In density mode, the links of the tile are accumulated and blended 
+// at once where they would be drawn, after the nodes
+void* CloudGraphRenderTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  CloudGraphRender *render = range->_render;
+  range->_success = false;
+  // Create the tools of the thread
+  CloudGraphRenderWorker worker;
+  worker._tile = NULL;
+  worker._offset = VecFloatCreate(2);
+  worker._font = CloudGraphCreateFont();
+  worker._pen = NULL;
+  worker._curve = BCurveCreate(3, 2);
+  worker._pos = VecFloatCreate(2);
+  worker._right = VecFloatCreate(2);
+  worker._sizeNode = VecFloatCreate(2);
+  worker._pix = VecShortCreate(2);
+  worker._count = NULL;
+  worker._sum = NULL;
+  bool density = (render->_opt->_linkRenderMode != 
+    CloudGraphOptLinkRenderCurve);
+  if (density) {
+    worker._count = (unsigned int*)malloc(sizeof(unsigned int) * 
+      (size_t)(render->_sizeTile[0]) * render->_sizeTile[1]);
+    worker._sum = (unsigned int*)malloc(sizeof(unsigned int) * 3 * 
+      (size_t)(render->_sizeTile[0]) * render->_sizeTile[1]);
+  }
+  VecShort *dim = VecShortCreate(2);
+  VecShort *pixTile = VecShortCreate(2);
+  VecShort *pix = VecShortCreate(2);
+  // Size of the font in the TGA
+  float fontSize = render->_opt->_fontSizeNode * render->_view._scale;
+  // Prepare the atlas of the glyphs of the node labels, with the 
+  // thickness of the pencil when the nodes are drawn
+  bool atlas = CloudGraphGlyphAtlasInit(&(worker._atlas), 
+    (render->_opt->_nodeLabelMode == CloudGraphOptNodeLabelAll ? 
+    render->_opt->_glyphRotations : 0), fontSize, 
+    2.0 * render->_view._scale);
+  if (atlas && worker._offset != NULL && worker._font != NULL && 
+    worker._curve != NULL && worker._pos != NULL && 
+    worker._right != NULL && worker._sizeNode != NULL && 
+    worker._pix != NULL && dim != NULL && pixTile != NULL && 
+    pix != NULL && (density == false || 
+    (worker._count != NULL && worker._sum != NULL))) {
+    // Set the size of the font and of the nodes
+    TGAFontSetSize(worker._font, fontSize);
+    for (int i = 2; i--;)
+      VecSet(worker._sizeNode, i, 0.5 * fontSize);
+    range->_success = true;
+    // Loop on the tiles of the task
+    int nbTile = render->_nbTile[0] * render->_nbTile[1];
+    for (int iTile = range->_firstTile; iTile < nbTile && 
+      range->_success; iTile += range->_stepTile) {
+      // Get the position and dimensions of the tile
+      int origin[2];
+      int size[2];
+      CloudGraphGetTile(render, iTile, origin, size);
+      for (int iDim = 2; iDim--;) {
+        VecSet(dim, iDim, size[iDim]);
+        worker._dim[iDim] = size[iDim];
+        VecSet(worker._offset, iDim, (float)(origin[iDim]));
+      }
+      if (size[0] <= 0 || size[1] <= 0)
+        continue;
+      // Create the TGA of the tile, and a new pencil with the default
+      // properties of the rendering
+      worker._tile = TGACreate(dim, render->_background);
+      worker._pen = TGAGetPencil();
+      if (worker._tile == NULL || worker._pen == NULL) {
+        range->_success = false;
+      } else {
+        TGAPencilSetShapeRound(worker._pen);
+        TGAPencilSetAntialias(worker._pen, true);
+        TGAPencilSetThickness(worker._pen, 2.0 * render->_view._scale);
+        // Accumulate the links of the tile
+        bool composited = true;
+        if (density) {
+          CloudGraphAccumulateLinks(render, iTile, worker._count, 
+            worker._sum);
+          composited = false;
+        }
+        // Draw the elements of the tile, the accumulated links are 
+        // blended before the first element after the nodes
+        for (int iElem = render->_offsets[iTile]; 
+          iElem < render->_offsets[iTile + 1] && range->_success; 
+          ++iElem) {
+          int elem = render->_elems[iElem];
+          if (density && elem >= render->_nbNode) {
+            if (composited == false) {
+              CloudGraphCompositeDensity(render, &worker);
+              composited = true;
+            }
+            if (elem < render->_nbNode + render->_nbLink)
+              continue;
+          }
+          range->_success = CloudGraphDrawElem(render, &worker, elem);
+        }
+        if (composited == false)
+          CloudGraphCompositeDensity(render, &worker);
+        // Copy the tile in the rendered TGA one row at a time, the 
+        // pixels of a row being contiguous in both
+        VecSet(pixTile, 0, 0);
+        VecSet(pix, 0, origin[0]);
+        for (int y = 0; y < size[1]; ++y) {
+          VecSet(pixTile, 1, y);
+          VecSet(pix, 1, origin[1] + y);
+          memcpy(TGAGetPix(render->_tga, pix), 
+            TGAGetPix(worker._tile, pixTile), 
+            sizeof(TGAPixel) * size[0]);
+        }
+      }
+      if (worker._tile != NULL)
+        TGAFree(&(worker._tile));
+      if (worker._pen != NULL)
+        TGAPencilFree(&(worker._pen));
+    }
+  }
+  // Free memory
+  VecFree(&(worker._offset));
+  if (worker._font != NULL)
+    TGAFreeFont(&(worker._font));
+  BCurveFree(&(worker._curve));
+  VecFree(&(worker._pos));
+  VecFree(&(worker._right));
+  VecFree(&(worker._sizeNode));
+  VecFree(&(worker._pix));
+  CloudGraphGlyphAtlasFree(&(worker._atlas));
+  if (worker._count != NULL)
+    free(worker._count);
+  if (worker._sum != NULL)
+    free(worker._sum);
+  VecFree(&dim);
+  VecFree(&pixTile);
+  VecFree(&pix);
+  return NULL;
+}
+
+// Thread function getting the greatest number of links crossing a 
+// pixel of the tiles of a task in density mode
+void* CloudGraphDensityTask(void *task) {
+  CloudGraphRangeTask *range = (CloudGraphRangeTask*)task;
+  CloudGraphRender *render = range->_render;
+  range->_maxCount = 0;
+  range->_success = false;
+  // Allocate the number of links of a tile
+  unsigned int *count = (unsigned int*)malloc(sizeof(unsigned int) * 
+    (size_t)(render->_sizeTile[0]) * render->_sizeTile[1]);
+  if (count == NULL)
+    return NULL;
+  // Loop on the tiles of the task
+  int nbTile = render->_nbTile[0] * render->_nbTile[1];
+  for (int iTile = range->_firstTile; iTile < nbTile; 
+    iTile += range->_stepTile) {
+    int origin[2];
+    int size[2];
+    CloudGraphGetTile(render, iTile, origin, size);
+    if (size[0] <= 0 || size[1] <= 0)
+      continue;
+    // Accumulate the links of the tile and update the greatest number
+    CloudGraphAccumulateLinks(render, iTile, count, NULL);
+    for (int iPix = size[0] * size[1]; iPix--;)
+      if (count[iPix] > range->_maxCount)
+        range->_maxCount = count[iPix];
+  }
+  free(count);
+  range->_success = true;
+  return NULL;
+}
+
+// Set 'count' to the number of links of the rendering 'render' 
+// crossing each pixel of the tile 'iTile', and 'sum' (may be NULL) to 
+// the sum of their colors
+// A link of weight w counts as w links if the weight of links is 
+// displayed, its color goes from the color of its first node to the 
+// one of its second node
+void CloudGraphAccumulateLinks(const CloudGraphRender *render, 
+  int iTile, unsigned int *count, unsigned int *sum) {
+  const CloudGraphColumns *cols = &(render->_cloud->_cols);
+  // Get the position and dimensions of the tile
+  int origin[2];
+  int size[2];
+  CloudGraphGetTile(render, iTile, origin, size);
+  // Reset the accumulation
+  memset(count, 0, sizeof(unsigned int) * size[0] * size[1]);
+  if (sum != NULL)
+    memset(sum, 0, sizeof(unsigned int) * 3 * size[0] * size[1]);
+  // Loop on the links of the tile
+  for (int iElem = render->_offsets[iTile]; 
+    iElem < render->_offsets[iTile + 1]; ++iElem) {
+    int iLink = render->_elems[iElem] - render->_nbNode;
+    if (iLink < 0 || iLink >= render->_nbLink)
+      continue;
+    // Get the control points of the link in the TGA, they are not 
+    // moved to the tile so the link is split and walked the same way 
+    // whatever the tiles
+    float ctrl[8];
+    if (CloudGraphGetRenderCurve(render, iLink, ctrl) == false)
+      continue;
+    // Get the weight and colors of the link, a color never set is the
+    // default black of the pencil
+    // The weight is clamped to the saturation of the count
+    unsigned int weight = 1;
+    if (render->_opt->_linkWeightMode != CloudGraphOptLinkWeightNone &&
+      cols->_link[iLink]->_weight > 1)
+      weight = (unsigned int)(cols->_link[iLink]->_weight);
+    if (weight > CLOUDGRAPH_DENSITYMAXCOUNT)
+      weight = CLOUDGRAPH_DENSITYMAXCOUNT;
+    unsigned char rgba[8] = {0, 0, 0, 255, 0, 0, 0, 255};
+    for (int iNode = 2; iNode--;)
+      if (render->_linkRgbaSet[iLink] & (1 << iNode))
+        memcpy(rgba + 4 * iNode, 
+          render->_linkRgba + 8 * (size_t)iLink + 4 * iNode, 4);
+    // Accumulate the link
+    float t[2] = {0.0, 1.0};
+    int last = -1;
+    CloudGraphAccumulateCurve(ctrl, origin, size, weight, rgba, t, 
+      CLOUDGRAPH_DENSITYMAXDEPTH, &last, count, sum);
+  }
+}
+
+// Add 'weight' to 'count' and 'weight' times the color to 'sum' (may 
+// be NULL) on the pixels crossed by the piece 't[0]' to 't[1]' of a
+// link, of control points 'ctrl' in the TGA, in the tile at 'origin' 
+// of dimensions 'size', splitting it up to 'depth' times
+// '*last' is the index of the last pixel of the tile written for this
+// link, it is counted only once, or -1 before its first piece and 
+// when the link is outside the tile
+// The piece is split in halves with the de Casteljau algorithm, the 
+// halves outside the tile are skipped, and the halves closer to their
+// chord than CLOUDGRAPH_DENSITYFLATNESS are walked one pixel at a time
+// along their major axis, so the cost is proportional to the length 
+// of the link inside the tile
+// The color goes from the first color of 'rgba' to the second along 
+// the link
+void CloudGraphAccumulateCurve(const float *ctrl, const int *origin,
+  const int *size, unsigned int weight, const unsigned char *rgba, 
+  const float *t, int depth, int *last, unsigned int *count, 
+  unsigned int *sum) {
+  // If the piece is outside the tile, nothing to do, the next pixel 
+  // of the tile is not the same as the last one
+  for (int iDim = 2; iDim--;) {
+    float min = ctrl[iDim];
+    float max = ctrl[iDim];
+    for (int iCtrl = 1; iCtrl < 4; ++iCtrl) {
+      if (ctrl[2 * iCtrl + iDim] < min)
+        min = ctrl[2 * iCtrl + iDim];
+      if (ctrl[2 * iCtrl + iDim] > max)
+        max = ctrl[2 * iCtrl + iDim];
+    }
+    if (max < (float)(origin[iDim]) || 
+      min >= (float)(origin[iDim] + size[iDim])) {
+      *last = -1;
+      return;
+    }
+  }
+  // Get the distance of the intermediate control points to the chord
+  float delta[2] = {ctrl[6] - ctrl[0], ctrl[7] - ctrl[1]};
+  float chord = sqrt(delta[0] * delta[0] + delta[1] * delta[1]);
+  float dist = 0.0;
+  for (int iCtrl = 1; iCtrl < 3; ++iCtrl) {
+    float v[2] = {ctrl[2 * iCtrl] - ctrl[0], 
+      ctrl[2 * iCtrl + 1] - ctrl[1]};
+    float d = (chord > CLOUDGRAPH_DENSITYFLATNESS ? 
+      fabs(v[0] * delta[1] - v[1] * delta[0]) / chord : 
+      sqrt(v[0] * v[0] + v[1] * v[1]));
+    if (d > dist)
+      dist = d;
+  }
+  // If the piece is not flat enough, split it in halves
+  if (dist > CLOUDGRAPH_DENSITYFLATNESS && depth > 0) {
+    float left[8];
+    float right[8];
+    for (int iDim = 2; iDim--;) {
+      float p01 = 0.5 * (ctrl[iDim] + ctrl[2 + iDim]);
+      float p12 = 0.5 * (ctrl[2 + iDim] + ctrl[4 + iDim]);
+      float p23 = 0.5 * (ctrl[4 + iDim] + ctrl[6 + iDim]);
+      float p012 = 0.5 * (p01 + p12);
+      float p123 = 0.5 * (p12 + p23);
+      float p0123 = 0.5 * (p012 + p123);
+      left[iDim] = ctrl[iDim];
+      left[2 + iDim] = p01;
+      left[4 + iDim] = p012;
+      left[6 + iDim] = p0123;
+      right[iDim] = p0123;
+      right[2 + iDim] = p123;
+      right[4 + iDim] = p23;
+      right[6 + iDim] = ctrl[6 + iDim];
+    }
+    float tLeft[2] = {t[0], 0.5 * (t[0] + t[1])};
+    float tRight[2] = {tLeft[1], t[1]};
+    CloudGraphAccumulateCurve(left, origin, size, weight, rgba, tLeft, 
+      depth - 1, last, count, sum);
+    CloudGraphAccumulateCurve(right, origin, size, weight, rgba, tRight,
+      depth - 1, last, count, sum);
+    return;
+  }
+  // Walk the chord one pixel at a time, its end is the start of the 
+  // next piece except for the end of the link
+  int nbStep = (int)ceil(fabs(delta[0]) > fabs(delta[1]) ? 
+    fabs(delta[0]) : fabs(delta[1]));
+  if (nbStep < 1)
+    nbStep = 1;
+  int lastStep = (t[1] >= 1.0 ? nbStep : nbStep - 1);
+  // Clip the walk to the part of the chord inside the tile, widened 
+  // by one step against the rounding
+  float sIn = 0.0;
+  float sOut = 1.0;
+  for (int iDim = 2; iDim--;) {
+    if (delta[iDim] != 0.0) {
+      float s0 = ((float)(origin[iDim]) - ctrl[iDim]) / delta[iDim];
+      float s1 = ((float)(origin[iDim] + size[iDim]) - ctrl[iDim]) / 
+        delta[iDim];
+      if (s0 > s1) {
+        float swap = s0;
+        s0 = s1;
+        s1 = swap;
+      }
+      if (s0 > sIn)
+        sIn = s0;
+      if (s1 < sOut)
+        sOut = s1;
+    }
+  }
+  int firstStep = (int)floor(sIn * (float)nbStep) - 1;
+  if (firstStep < 0)
+    firstStep = 0;
+  // The steps clipped at the start are outside the tile
+  if (firstStep > 0)
+    *last = -1;
+  if ((int)ceil(sOut * (float)nbStep) + 1 < lastStep)
+    lastStep = (int)ceil(sOut * (float)nbStep) + 1;
+  for (int iStep = firstStep; iStep <= lastStep; ++iStep) {
+    float s = (float)iStep / (float)nbStep;
+    int x = (int)floor(ctrl[0] + delta[0] * s) - origin[0];
+    int y = (int)floor(ctrl[1] + delta[1] * s) - origin[1];
+    if (x < 0 || y < 0 || x >= size[0] || y >= size[1]) {
+      *last = -1;
+      continue;
+    }
+    // Count the pixel once even if several steps, or the end and start
+    // of two consecutive pieces, fall in it
+    int iPix = y * size[0] + x;
+    if (iPix == *last)
+      continue;
+    *last = iPix;
+    if (count[iPix] > CLOUDGRAPH_DENSITYMAXCOUNT - weight)
+      continue;
+    count[iPix] += weight;
+    if (sum != NULL) {
+      float along = t[0] + (t[1] - t[0]) * s;
+      for (int iRgb = 3; iRgb--;)
+        sum[3 * iPix + iRgb] += weight * (unsigned int)(
+          (float)(rgba[iRgb]) * (1.0 - along) + 
+          (float)(rgba[4 + iRgb]) * along + 0.5);
+    }
+  }
+}
+
+// Blend the links accumulated in the tile of 'worker' with the tile,
+// tone mapped with the mode of 'render'
+// The color of a pixel is the average color of its links, blended 
+// with an opacity proportional to its number of links, or to its log,
+// relative to the greatest number of links on a pixel of the TGA
+void CloudGraphCompositeDensity(const CloudGraphRender *render, 
+  CloudGraphRenderWorker *worker) {
+  if (render->_maxCount == 0)
+    return;
+  bool logScale = (render->_opt->_linkRenderMode == 
+    CloudGraphOptLinkRenderDensityLog);
+  float norm = (logScale ? 
+    log1p((float)(render->_maxCount)) : (float)(render->_maxCount));
+  // Loop on the rows of the tile, the pixels of a row are contiguous 
+  // and blended through a pointer to the first one
+  VecSet(worker->_pix, 0, 0);
+  for (int y = 0; y < worker->_dim[1]; ++y) {
+    VecSet(worker->_pix, 1, y);
+    TGAPixel *pixel = TGAGetPix(worker->_tile, worker->_pix);
+    for (int x = 0; x < worker->_dim[0]; ++x) {
+      int iPix = y * worker->_dim[0] + x;
+      unsigned int count = worker->_count[iPix];
+      if (count == 0)
+        continue;
+      // Get the opacity of the pixel
+      float alpha = (logScale ? log1p((float)count) : (float)count) / 
+        norm;
+      // Blend the average color with the pixel
+      for (int iRgba = 4; iRgba--;) {
+        float col = (iRgba == 3 ? 255.0 : 
+          (float)(worker->_sum[3 * iPix + iRgba]) / (float)count);
+        pixel[x]._rgba[iRgba] = (unsigned char)(
+          (float)(pixel[x]._rgba[iRgba]) * (1.0 - alpha) + 
+          col * alpha + 0.5);
+      }
+    }
+  }
+}
+
+// Draw the element 'iElem' of the rendering 'render' on the tile of 
+// 'worker'
+// The pencil is set as it would be if all the elements were drawn in
+// order, the nodes are drawn with the pencil as created for the tile
+// Return false if memory allocation failed, else return true
+bool CloudGraphDrawElem(CloudGraphRender *render, 
+  CloudGraphRenderWorker *worker, int iElem) {
+  const CloudGraph *cloud = render->_cloud;
+  const CloudGraphOpt *opt = render->_opt;
+  const CloudGraphColumns *cols = &(cloud->_cols);
+  const CloudGraphView *view = &(render->_view);
+  TGAPencil *pen = worker->_pen;
+  float pix[2];
+  // If the element is a node
+  if (iElem < render->_nbNode) {
+    int iNode = iElem;
+    CloudGraphNode *node = cols->_node[iNode];
+    CloudGraphFamily *family = 
+      CloudGraphGetFamily(cloud, cols->_family[iNode]);
+    // Set the color of the pencil to the color of the family
+    TGAPencilSetColRGBA(pen, family->_rgba);
+    // Draw the node, copying the disc rasterized at the closest 
+    // subpixel position if there are sprites
+    CloudGraphViewPoint(view, cols->_x[iNode], cols->_y[iNode], pix);
+    for (int iDim = 2; iDim--;)
+      pix[iDim] -= VecGet(worker->_offset, iDim);
+    if (render->_sprites != NULL) {
+      int at[2];
+      int phase[2];
+      for (int iDim = 2; iDim--;) {
+        int sub = (int)floor(pix[iDim] * CLOUDGRAPH_SPRITEPHASE + 0.5);
+        at[iDim] = (int)floor((float)sub / CLOUDGRAPH_SPRITEPHASE);
+        phase[iDim] = sub - at[iDim] * CLOUDGRAPH_SPRITEPHASE;
+      }
+      const CloudGraphGlyph *sprite = render->_sprites + 
+        phase[1] * CLOUDGRAPH_SPRITEPHASE + phase[0];
+      for (int iDim = 2; iDim--;)
+        at[iDim] += sprite->_origin[iDim];
+      CloudGraphBlendMask(worker, sprite, at, family->_rgba);
+    } else {
+      VecSet(worker->_pos, 0, pix[0]);
+      VecSet(worker->_pos, 1, pix[1]);
+      TGAFillEllipse(worker->_tile, worker->_pos, worker->_sizeNode, 
+        pen);
+    }
+    // If this node label must be displayed
+    if (opt->_nodeLabelMode == CloudGraphOptNodeLabelAll) {
+      // Set the position for the label string
+      CloudGraphViewPoint(view, node->_boundingBoxLbl._pos[0], 
+        node->_boundingBoxLbl._pos[1], pix);
+      for (int iDim = 2; iDim--;)
+        pix[iDim] -= VecGet(worker->_offset, iDim);
+      // If the glyphs are in the atlas, copy them
+      if (worker->_atlas._nbRotation > 0)
+        return CloudGraphPrintLabel(worker, node->_label, pix, 
+          node->_right, family->_rgba);
+      VecSet(worker->_pos, 0, pix[0]);
+      VecSet(worker->_pos, 1, pix[1]);
+      // Set the angle of the font
+      VecSet(worker->_right, 0, node->_right[0]);
+      VecSet(worker->_right, 1, node->_right[1]);
+      TGAFontSetRight(worker->_font, worker->_right);
+      // Draw the string
+      TGAPrintString(worker->_tile, pen, worker->_font, 
+        (unsigned char*)(node->_label), worker->_pos);
+    }
+  // Else, if the element is a link
+  } else if (iElem < render->_nbNode + render->_nbLink) {
+    int iLink = iElem - render->_nbNode;
+    // Set the pen mode
+    TGAPencilSetModeColorBlend(pen, 0, 1);
+    // Set the colors
+    for (int iNode = 2; iNode--;) {
+      TGAPencilSelectColor(pen, iNode);
+      if (render->_linkRgbaSet[iLink] & (1 << iNode))
+        TGAPencilSetColRGBA(pen, 
+          render->_linkRgba + 8 * (size_t)iLink + 4 * iNode);
+    }
+    // Set the thickness, it grows with the log of the weight of the 
+    // link in thickness mode
+    if (opt->_linkWeightMode == CloudGraphOptLinkWeightThickness)
+      TGAPencilSetThickness(pen, 2.0 * view->_scale * 
+        (1.0 + log2((float)(cols->_link[iLink]->_weight))));
+    // Set the control points of the curve at their position in the 
+    // tile
+    float ctrl[8];
+    CloudGraphGetRenderCurve(render, iLink, ctrl);
+    for (int iCtrl = 4; iCtrl--;)
+      for (int iDim = 2; iDim--;)
+        VecSet(worker->_curve->_ctrl[iCtrl], iDim, 
+          ctrl[2 * iCtrl + iDim] - VecGet(worker->_offset, iDim));
+    // Draw the link
+    TGADrawCurve(worker->_tile, worker->_curve, pen);
+  // Else the element is the label of a family
+  } else {
+    CloudGraphFamily *family = 
+      render->_families[iElem - render->_nbNode - render->_nbLink];
+    // Set the pen mode
+    TGAPencilSetModeColorSolid(pen);
+    TGAPencilSetThickness(pen, 
+      render->_familyThickness * view->_scale);
+    if (render->_nbLink > 0)
+      TGAPencilSelectColor(pen, 0);
+    // Set the color
+    TGAPencilSetColRGBA(pen, family->_rgba);
+    // Set the angle of the font
+    VecSet(worker->_right, 0, family->_right[0]);
+    VecSet(worker->_right, 1, family->_right[1]);
+    TGAFontSetRight(worker->_font, worker->_right);
     // Set the position
-    VecSet(family->_pos, 0, r + opt->_fontSizeNode);
-    VecSet(family->_pos, 1, 0.0);
-    VecRot2D(family->_pos, posFamily[family->_id]);
-    // Set the right direction
-    VecSet(family->_right, 0, 1.0);
-    VecSet(family->_right, 1, 0.0);
-    VecRot2D(family->_right, posFamily[family->_id]);
-    // Move to next family
-    ptr = ptr->_next;
+    CloudGraphViewPoint(view, family->_pos[0], family->_pos[1], pix);
+    VecSet(worker->_pos, 0, pix[0]);
+    VecSet(worker->_pos, 1, pix[1]);
+    VecOp(worker->_pos, 1.0, worker->_offset, -1.0);
+    // Draw the string
+    TGAPrintString(worker->_tile, pen, worker->_font, 
+      (unsigned char*)(family->_label), worker->_pos);
   }
-  // Free memory
-  free(posFamily);
-  free(nbFamily);
-  // Return success code
   return true;
 }
 
-// Arrange the position of the nodes of the graph
-// Return true if it could arrange nodes
-// Return false if arguments are invalid or it couldn't arrange nodes
-bool CloudGraphArrange(CloudGraph *cloud, CloudGraphOpt *opt) {
-  // Check arguments
-  if (cloud == NULL || opt == NULL)
+// Prepare the empty atlas of glyphs 'atlas' with 'nbRotation' 
+// rotations, for a font of size 'size' and a pencil of thickness 
+// 'thickness'
+// The glyphs are rasterized in black on white with the same font and 
+// pencil properties as the labels drawn without the atlas
+// Return false if memory allocation failed, else return true
+bool CloudGraphGlyphAtlasInit(CloudGraphGlyphAtlas *atlas, 
+  int nbRotation, float size, float thickness) {
+  // Set the properties of the atlas
+  atlas->_nbRotation = nbRotation;
+  atlas->_size = size;
+  atlas->_thickness = thickness;
+  for (int c = 256; c--;) {
+    atlas->_advance[c] = -1.0;
+    atlas->_glyphs[c] = NULL;
+  }
+  atlas->_font = NULL;
+  atlas->_pen = NULL;
+  // If the atlas is not used, nothing else to do
+  if (nbRotation == 0)
+    return true;
+  // Create the font and pencil
+  atlas->_font = CloudGraphCreateFont();
+  atlas->_pen = TGAGetPencil();
+  if (atlas->_font == NULL || atlas->_pen == NULL)
     return false;
-  // Ensure the nodes are ordered by family
-  CloudGraphSortNodeByFamily(cloud);
-  // Declare a variable for the return value
-  bool ret = true;
-  // Set initial position of nodes depending on representation mode
-  // If the representation is circle or free
-  if (opt->_mode == CloudGraphModeCircle) {
-    ret = CloudGraphArrangeCircle(cloud, opt);
-  } else if (opt->_mode == CloudGraphModeLine) {
-    ret = CloudGraphArrangeLine(cloud, opt);
+  TGAFontSetSize(atlas->_font, size);
+  TGAPencilSetShapeRound(atlas->_pen);
+  TGAPencilSetAntialias(atlas->_pen, true);
+  TGAPencilSetThickness(atlas->_pen, thickness);
+  unsigned char black[4] = {0, 0, 0, 255};
+  TGAPencilSetColRGBA(atlas->_pen, black);
+  return true;
+}
+
+// Free the memory used by the atlas of glyphs 'atlas'
+void CloudGraphGlyphAtlasFree(CloudGraphGlyphAtlas *atlas) {
+  for (int c = 256; c--;) {
+    if (atlas->_glyphs[c] == NULL)
+      continue;
+    for (int iRotation = atlas->_nbRotation; iRotation--;)
+      if (atlas->_glyphs[c][iRotation]._mask != NULL)
+        free(atlas->_glyphs[c][iRotation]._mask);
+    free(atlas->_glyphs[c]);
+    atlas->_glyphs[c] = NULL;
   }
-  // Update the bounding boxes of nodes and families' labels
-  CloudGraphUpdateBoundingBox(cloud, opt);
-  // Return the success value
-  return ret;
+  if (atlas->_font != NULL)
+    TGAFreeFont(&(atlas->_font));
+  if (atlas->_pen != NULL)
+    TGAPencilFree(&(atlas->_pen));
 }
 
-// Get a TGA picture representing the CloudGraph using the graphical
-// options 'opt'
-// Return NULL if we couldn't create the TGA
-TGA* CloudGraphToTGA(CloudGraph *cloud, CloudGraphOpt *opt) {
-  // Check arguments
-  if (cloud == NULL || opt == NULL)
-    return NULL;
-  // Declare a variable for the returned TGA
-  TGA *tga = NULL;
-  // Declare a variable to memorize the size of nodes
-  VecFloat *sizeNode = VecFloatCreate(2);
-  // Declare a vector to calculate positions
-  VecFloat *pos = VecFloatCreate(2);
-  // Create a default pencil
-  TGAPencil *pen = TGAGetPencil();
-  // Create a pixel for drawing
-  TGAPixel *pixel = TGAGetWhitePixel();
-  // Declare a variable to memorize the dimensions of the tga
+// Get the advance of the character 'c' along the right direction of a
+// label printed with the font of 'atlas'
+// The advance is the difference of width between the string made of 
+// the character twice and the character alone
+float CloudGraphGetGlyphAdvance(CloudGraphGlyphAtlas *atlas, 
+  unsigned char c) {
+  // If the advance is already known, return it
+  if (atlas->_advance[c] >= 0.0)
+    return atlas->_advance[c];
+  // Measure the character alone and twice
+  unsigned char str[3] = {c, c, '\0'};
+  Shapoid *twice = TGAFontGetStringBound(atlas->_font, str);
+  str[1] = '\0';
+  Shapoid *once = TGAFontGetStringBound(atlas->_font, str);
+  float advance = 0.0;
+  if (twice != NULL && once != NULL)
+    advance = VecNorm(twice->_axis[0]) - VecNorm(once->_axis[0]);
+  if (advance < 0.0)
+    advance = 0.0;
+  if (twice != NULL)
+    ShapoidFree(&twice);
+  if (once != NULL)
+    ShapoidFree(&once);
+  atlas->_advance[c] = advance;
+  return advance;
+}
+
+// Get the glyph of the character 'c' at the rotation 'iRotation' of 
+// 'atlas', rasterizing it if it's its first use
+// The glyph is printed in a square TGA large enough for any rotation,
+// and its coverage is cropped to the pixels it actually covers
+// Return NULL if memory allocation failed
+const CloudGraphGlyph* CloudGraphGetGlyph(CloudGraphGlyphAtlas *atlas,
+  unsigned char c, int iRotation) {
+  // Allocate the glyphs of the character at its first use
+  if (atlas->_glyphs[c] == NULL) {
+    atlas->_glyphs[c] = (CloudGraphGlyph*)calloc(
+      (size_t)(atlas->_nbRotation), sizeof(CloudGraphGlyph));
+    if (atlas->_glyphs[c] == NULL)
+      return NULL;
+  }
+  CloudGraphGlyph *glyph = atlas->_glyphs[c] + iRotation;
+  // If the glyph is already rasterized, return it
+  if (glyph->_done)
+    return glyph;
+  // Get the half size of the TGA, the glyph is printed at its center
+  float advance = CloudGraphGetGlyphAdvance(atlas, c);
+  int half = (int)ceil(advance + atlas->_size + atlas->_thickness) + 2;
+  // Declare the variables to rasterize the glyph
   VecShort *dim = VecShortCreate(2);
-  // Declare a variable to memorize empty family
-  bool *emptyFamily = 
-    (bool*)malloc(sizeof(bool) * cloud->_families->_nbElem);
-  // If we couldn't allocate memory
-  if (pos == NULL || sizeNode == NULL || pen == NULL || pixel == NULL ||
-    dim == NULL || emptyFamily == NULL) {
-    // Free memory and stop here
-    VecFree(&pos);
-    VecFree(&sizeNode);
-    VecFree(&dim);
-    TGAPixelFree(&pixel);
-    TGAPencilFree(&pen);
-    if (emptyFamily != NULL) free(emptyFamily);
-    return NULL;
+  VecFloat *pos = VecFloatCreate(2);
+  VecFloat *right = VecFloatCreate(2);
+  TGAPixel *white = TGAGetWhitePixel();
+  TGA *tga = NULL;
+  bool success = false;
+  if (dim != NULL && pos != NULL && right != NULL && white != NULL) {
+    VecSet(dim, 0, 2 * half);
+    VecSet(dim, 1, 2 * half);
+    tga = TGACreate(dim, white);
   }
-  // Set the family to empty by default
-  for (int iFamily = cloud->_families->_nbElem; iFamily--;)
-    emptyFamily[iFamily] = true;
-  // Set the dimension of the tga
-  for (int i = 2; i--;)
-    VecSet(dim, i, 
-      (short)floor(VecGet(cloud->_boundingBox->_axis[i], i)));
-  // Set the size of the node, it's equal to the size of the font
-  for (int i = 2; i--;)
-    VecSet(sizeNode, i, 0.5 * opt->_fontSizeNode);
-  // Create the TGA
-  tga = TGACreate(dim, pixel);
-  // If we couldn't create the tga
-  if (tga == NULL) {
-    // Free memory and stop here
-    VecFree(&pos);
-    VecFree(&sizeNode);
-    TGAPixelFree(&pixel);
-    TGAPencilFree(&pen);
-    free(emptyFamily);
-    return NULL;
+  if (tga != NULL) {
+    // Print the glyph at the rotation
+    float theta = 2.0 * PBMATH_PI * (float)iRotation / 
+      (float)(atlas->_nbRotation);
+    VecSet(right, 0, cos(theta));
+    VecSet(right, 1, sin(theta));
+    TGAFontSetRight(atlas->_font, right);
+    VecSet(pos, 0, (float)half);
+    VecSet(pos, 1, (float)half);
+    unsigned char str[2] = {c, '\0'};
+    TGAPrintString(tga, atlas->_pen, atlas->_font, str, pos);
+    // Get the coverage of the glyph
+    success = CloudGraphSetMask(glyph, tga, half);
+    glyph->_done = success;
   }
-  // Set the pen properties
-  TGAPencilSetShapeRound(pen);
-  TGAPencilSetAntialias(pen, true);
-  TGAPencilSetThickness(pen, 2.0);
-  // Set the font size
-  TGAFontSetSize(cloud->_font, opt->_fontSizeNode);
-  // Declare a pointer toward the nodes
-  GSetElem *ptr = cloud->_nodes->_head;
-  // Loop on the nodes
-  while (ptr != NULL) {
-    // Declare a pointer to the node
-    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
-    // Update family emptiness
-    emptyFamily[node->_family] = false;
-    // Declare a pointer to the family of the node
-    CloudGraphFamily *family = GSetGet(cloud->_families, 
-      node->_family);
-    // If we could get the family
-    if (family != NULL) {
-      // Set the color of the pencil to the color of the family
-      TGAPencilSetColRGBA(pen, family->_rgba);
-      // Draw the node
-      VecCopy(pos, node->_pos);
-      VecOp(pos, 1.0, cloud->_boundingBox->_pos, -1.0);
-      TGAFillEllipse(tga, pos, sizeNode, pen);
-      // If this node label must be displayed
-      if (opt->_nodeLabelMode == CloudGraphOptNodeLabelAll) {
-        // Set the position for the label string
-        VecCopy(pos, node->_boundingBoxLbl->_pos);
-        VecOp(pos, 1.0, cloud->_boundingBox->_pos, -1.0);
-        // Set the angle of the font
-        TGAFontSetRight(cloud->_font, node->_right);
-        // Draw the string
-        TGAPrintString(tga, pen, cloud->_font, 
-          (unsigned char*)(node->_label), pos);
+  // Free memory
+  if (tga != NULL)
+    TGAFree(&tga);
+  VecFree(&dim);
+  VecFree(&pos);
+  VecFree(&right);
+  TGAPixelFree(&white);
+  return (success ? glyph : NULL);
+}
+
+// Set the coverage mask 'mask' from 'tga', of dimensions 2 * 'half' 
+// and drawn in black on white, the darker the more covered
+// The mask is cropped to the covered pixels, its origin is relative to
+// the center of 'tga'
+// Return false if memory allocation failed, else return true
+bool CloudGraphSetMask(CloudGraphGlyph *mask, TGA *tga, int half) {
+  VecShort *pix = VecShortCreate(2);
+  if (pix == NULL)
+    return false;
+  // Get the bounds of the covered pixels
+  int min[2] = {2 * half, 2 * half};
+  int max[2] = {-1, -1};
+  for (int y = 0; y < 2 * half; ++y) {
+    for (int x = 0; x < 2 * half; ++x) {
+      VecSet(pix, 0, x);
+      VecSet(pix, 1, y);
+      if (TGAGetPix(tga, pix)->_rgba[0] == 255)
+        continue;
+      int at[2] = {x, y};
+      for (int iDim = 2; iDim--;) {
+        if (at[iDim] < min[iDim])
+          min[iDim] = at[iDim];
+        if (at[iDim] > max[iDim])
+          max[iDim] = at[iDim];
       }
     }
-    // Move to next node
-    ptr = ptr->_next;
   }
-  // Set the pointer to the head of the set of links
-  ptr = cloud->_links->_head;
-  // Set the pen mode
-  TGAPencilSetModeColorBlend(pen, 0, 1);
-  // Loop on the links
-  while (ptr != NULL) {
-    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
-    // Set the colors
-    for (int iNode = 2; iNode--;) {
-      CloudGraphFamily *family = 
-        CloudGraphGetFamily(cloud, link->_families[iNode]);
-      TGAPencilSelectColor(pen, iNode);
-      TGAPencilSetColRGBA(pen, family->_rgba);
+  // Copy the coverage of the covered pixels
+  bool success = true;
+  mask->_mask = NULL;
+  mask->_dim[0] = mask->_dim[1] = 0;
+  mask->_origin[0] = mask->_origin[1] = 0;
+  if (max[0] >= min[0]) {
+    for (int iDim = 2; iDim--;) {
+      mask->_dim[iDim] = max[iDim] - min[iDim] + 1;
+      mask->_origin[iDim] = min[iDim] - half;
+    }
+    mask->_mask = (unsigned char*)malloc(
+      (size_t)(mask->_dim[0]) * (size_t)(mask->_dim[1]));
+    if (mask->_mask == NULL) {
+      success = false;
+    } else {
+      for (int y = 0; y < mask->_dim[1]; ++y) {
+        for (int x = 0; x < mask->_dim[0]; ++x) {
+          VecSet(pix, 0, min[0] + x);
+          VecSet(pix, 1, min[1] + y);
+          mask->_mask[y * mask->_dim[0] + x] = 
+            255 - TGAGetPix(tga, pix)->_rgba[0];
+        }
+      }
     }
-    // Translate the curve to its position
-    VecOp(cloud->_boundingBox->_pos, -1.0, NULL, 0.0);
-    BCurveTranslate(link->_curve, cloud->_boundingBox->_pos);
-    VecOp(cloud->_boundingBox->_pos, -1.0, NULL, 0.0);
-    // Draw the link
-    TGADrawCurve(tga, link->_curve, pen);
-    // Put back the curve to it original position
-    BCurveTranslate(link->_curve, cloud->_boundingBox->_pos);    
-    // Move to next link
-    ptr = ptr->_next;
   }
-  // If the families label must be displayed
-  if (opt->_familyLabelMode == CloudGraphOptFamilyLabelAll) {
-    // Set the pen mode
-    TGAPencilSetModeColorSolid(pen);
-    // Set the pointer to the head of the set of families
-    ptr = cloud->_families->_head;
-    // Loop on the families
-    while (ptr != NULL) {
-      CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
-      // If this family is not empty
-      if (emptyFamily[family->_id] == false) {
-        // Set the color
-        TGAPencilSetColRGBA(pen, family->_rgba);
-        // Set the angle of the font
-        TGAFontSetRight(cloud->_font, family->_right);
-        // Set the position
-        VecCopy(pos, family->_pos);
-        VecOp(pos, 1.0, cloud->_boundingBox->_pos, -1.0);
-        // Draw the string
-        TGAPrintString(tga, pen, cloud->_font, 
-          (unsigned char*)(family->_label), pos);
+  VecFree(&pix);
+  return success;
+}
+
+// Blend the color 'rgba' with the pixels of the tile of 'worker' 
+// proportionally to the coverage 'mask', whose first pixel is at 'at'
+// in the tile
+// The pixels outside the tile are ignored
+void CloudGraphBlendMask(CloudGraphRenderWorker *worker, 
+  const CloudGraphGlyph *mask, const int *at, 
+  const unsigned char *rgba) {
+  // Get the part of the mask inside the tile
+  int first[2];
+  int last[2];
+  for (int iDim = 2; iDim--;) {
+    first[iDim] = (at[iDim] < 0 ? -at[iDim] : 0);
+    last[iDim] = mask->_dim[iDim];
+    if (at[iDim] + last[iDim] > worker->_dim[iDim])
+      last[iDim] = worker->_dim[iDim] - at[iDim];
+  }
+  if (first[0] >= last[0])
+    return;
+  // Loop on the rows of the mask, the pixels of a row of the tile are
+  // contiguous and blended through a pointer to the first one
+  float scale = (float)(rgba[3]) / 65025.0;
+  VecSet(worker->_pix, 0, at[0] + first[0]);
+  for (int y = first[1]; y < last[1]; ++y) {
+    const unsigned char *coverage = 
+      mask->_mask + y * mask->_dim[0] + first[0];
+    VecSet(worker->_pix, 1, at[1] + y);
+    TGAPixel *pixel = TGAGetPix(worker->_tile, worker->_pix);
+    for (int x = last[0] - first[0]; x--;) {
+      if (coverage[x] == 0)
+        continue;
+      float alpha = (float)(coverage[x]) * scale;
+      for (int iRgba = 4; iRgba--;) {
+        float col = (iRgba == 3 ? 255.0 : (float)(rgba[iRgba]));
+        pixel[x]._rgba[iRgba] = (unsigned char)(
+          (float)(pixel[x]._rgba[iRgba]) * (1.0 - alpha) + 
+          col * alpha + 0.5);
       }
-      // Move to next family
-      ptr = ptr->_next;
+    }
+  }
+}
+
+// Rasterize the disc of the nodes of the rendering 'render' centered
+// at each of the CLOUDGRAPH_SPRITEPHASE x CLOUDGRAPH_SPRITEPHASE 
+// subpixel positions
+// The disc is filled with the same pencil as the nodes drawn without 
+// sprites
+// Return false if memory allocation failed, else return true
+bool CloudGraphRenderSprites(CloudGraphRender *render) {
+  // Allocate the sprites
+  render->_sprites = (CloudGraphGlyph*)calloc(
+    CLOUDGRAPH_SPRITEPHASE * CLOUDGRAPH_SPRITEPHASE, 
+    sizeof(CloudGraphGlyph));
+  if (render->_sprites == NULL)
+    return false;
+  // Get the radius of the disc and the half size of the TGA, the disc
+  // is drawn at its center
+  float radius = 0.5 * render->_opt->_fontSizeNode * render->_view._scale;
+  int half = (int)ceil(radius) + 4;
+  // Declare the variables to rasterize the disc
+  VecShort *dim = VecShortCreate(2);
+  VecFloat *pos = VecFloatCreate(2);
+  VecFloat *size = VecFloatCreate(2);
+  TGAPixel *white = TGAGetWhitePixel();
+  TGAPencil *pen = TGAGetPencil();
+  bool success = (dim != NULL && pos != NULL && size != NULL && 
+    white != NULL && pen != NULL);
+  if (success) {
+    VecSet(dim, 0, 2 * half);
+    VecSet(dim, 1, 2 * half);
+    VecSet(size, 0, radius);
+    VecSet(size, 1, radius);
+    TGAPencilSetShapeRound(pen);
+    TGAPencilSetAntialias(pen, true);
+    TGAPencilSetThickness(pen, 2.0 * render->_view._scale);
+    unsigned char black[4] = {0, 0, 0, 255};
+    TGAPencilSetColRGBA(pen, black);
+  }
+  // Loop on the subpixel positions
+  for (int iSprite = 0; success && 
+    iSprite < CLOUDGRAPH_SPRITEPHASE * CLOUDGRAPH_SPRITEPHASE; 
+    ++iSprite) {
+    TGA *tga = TGACreate(dim, white);
+    if (tga == NULL) {
+      success = false;
+    } else {
+      VecSet(pos, 0, (float)half + (float)(iSprite % 
+        CLOUDGRAPH_SPRITEPHASE) / (float)CLOUDGRAPH_SPRITEPHASE);
+      VecSet(pos, 1, (float)half + (float)(iSprite / 
+        CLOUDGRAPH_SPRITEPHASE) / (float)CLOUDGRAPH_SPRITEPHASE);
+      TGAFillEllipse(tga, pos, size, pen);
+      success = CloudGraphSetMask(render->_sprites + iSprite, tga, half);
+      TGAFree(&tga);
     }
   }
   // Free memory
-  VecFree(&pos);
-  VecFree(&sizeNode);
-  TGAPixelFree(&pixel);
-  TGAPencilFree(&pen);
   VecFree(&dim);
-  free(emptyFamily);
-  // Return the TGA
-  return tga;
+  VecFree(&pos);
+  VecFree(&size);
+  TGAPixelFree(&white);
+  if (pen != NULL)
+    TGAPencilFree(&pen);
+  return success;
+}
+
+// Print the string 'label' in the tile of 'worker' at 'pos' in the 
+// tile, in the direction 'right' and the color 'rgba', copying the
+// glyphs of the atlas of 'worker'
+// Each glyph is placed at its exact position along 'right', rounded 
+// to the nearest pixel, and copied at the rotation of the atlas the 
+// closest to 'right', blending 'rgba' with the pixels of the tile 
+// proportionally to the coverage of the glyph
+// Return false if memory allocation failed, else return true
+bool CloudGraphPrintLabel(CloudGraphRenderWorker *worker, 
+  const char *label, const float *pos, const float *right, 
+  const unsigned char *rgba) {
+  CloudGraphGlyphAtlas *atlas = &(worker->_atlas);
+  if (label == NULL)
+    return true;
+  // Get the direction of the label and the closest rotation
+  float norm = sqrt(right[0] * right[0] + right[1] * right[1]);
+  float dir[2] = {1.0, 0.0};
+  if (norm > 0.0) {
+    dir[0] = right[0] / norm;
+    dir[1] = right[1] / norm;
+  }
+  int iRotation = (int)floor(atan2(dir[1], dir[0]) * 
+    (float)(atlas->_nbRotation) / (2.0 * PBMATH_PI) + 0.5);
+  iRotation %= atlas->_nbRotation;
+  if (iRotation < 0)
+    iRotation += atlas->_nbRotation;
+  // Loop on the characters
+  float along = 0.0;
+  for (const unsigned char *c = (const unsigned char*)label; *c != '\0';
+    ++c) {
+    const CloudGraphGlyph *glyph = CloudGraphGetGlyph(atlas, *c, 
+      iRotation);
+    if (glyph == NULL)
+      return false;
+    // Get the pixel of the tile where the glyph is printed
+    int at[2];
+    for (int iDim = 2; iDim--;)
+      at[iDim] = (int)floor(pos[iDim] + dir[iDim] * along + 0.5) + 
+        glyph->_origin[iDim];
+    along += CloudGraphGetGlyphAdvance(atlas, *c);
+    // Blend the covered pixels
+    CloudGraphBlendMask(worker, glyph, at, rgba);
+  }
+  return true;
 }
 
 // Update all the bounding boxes
@@ -1148,109 +7757,230 @@ void CloudGraphUpdateBoundingBox(CloudGraph *cloud,
   // Check arguments
   if (cloud == NULL || opt == NULL)
     return;
-  // Declare a variable to create the set of all bounding boxes
-  GSet *set = GSetCreate();
-  // If we couldn't allocate memory
-  if (set == NULL) {
-    return;
-  }
-  // Declare a pointer to go through the sets
-  GSetElem *ptr = cloud->_nodes->_head;
-  // Set the size of the font to the node font size
-  TGAFontSetSize(cloud->_font, opt->_fontSizeNode);
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
   //Declare a variable to memorize the length of longest label
   float maxLength = 0.0;
   // Loop through nodes
-  while (ptr != NULL) {
-    CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
+  for (int iNode = 0; iNode < cols->_nbNode; ++iNode) {
+    CloudGraphNode *node = cols->_node[iNode];
     // Update the bounding box for the node
-    VecCopy(node->_boundingBox->_pos, node->_pos);
-    VecSet(node->_boundingBox->_axis[0], 0, opt->_fontSizeNode);
-    VecSet(node->_boundingBox->_axis[0], 1, 0.0);
-    VecSet(node->_boundingBox->_axis[1], 0, 0.0);
-    VecSet(node->_boundingBox->_axis[1], 1, opt->_fontSizeNode);
-    VecOp(node->_boundingBox->_pos, 1.0, 
-      node->_boundingBox->_axis[0], -0.5);
-    VecOp(node->_boundingBox->_pos, 1.0, 
-      node->_boundingBox->_axis[1], -0.5);
-    // Create the bounding box for the label
-    if (node->_boundingBoxLbl != NULL)
-      ShapoidFree(&(node->_boundingBoxLbl));
-    TGAFontSetRight(cloud->_font, node->_right);
-    node->_boundingBoxLbl = TGAFontGetStringBound(cloud->_font, 
-      (unsigned char*)(node->_label));
+    CloudGraphBox *box = &(node->_boundingBox);
+    box->_pos[0] = cols->_x[iNode] - 0.5 * opt->_fontSizeNode;
+    box->_pos[1] = cols->_y[iNode] - 0.5 * opt->_fontSizeNode;
+    box->_axis[0][0] = opt->_fontSizeNode;
+    box->_axis[0][1] = 0.0;
+    box->_axis[1][0] = 0.0;
+    box->_axis[1][1] = opt->_fontSizeNode;
+    // Update the bounding box for the label, from the cached size of 
+    // the label rotated to the right of the node
+    float width = 0.0;
+    float height = 0.0;
+    CloudGraphGetNodeLabelMetric(cloud, node, opt->_fontSizeNode, 
+      &width, &height);
+    CloudGraphSetLabelBound(&(node->_boundingBoxLbl), width, height,
+      node->_right);
     // Update the length of longest label
-    float l = VecNorm(node->_boundingBoxLbl->_axis[0]);
-    if (l > maxLength)
-      maxLength = l;
+    if (width > maxLength)
+      maxLength = width;
     // Place the bounding box for the label
-    VecCopy(node->_boundingBoxLbl->_pos, node->_pos);
-    VecOp(node->_boundingBoxLbl->_pos, 1.0, 
-      node->_right, opt->_fontSizeNode);
-    // Add the bounding box to the set 
-    GSetAppend(set, node->_boundingBox);
-    // if the node labels are displayed
-    if (opt->_nodeLabelMode != CloudGraphOptNodeLabelNone)
-      // Add the label's bounding box to the set 
-      GSetAppend(set, node->_boundingBoxLbl);
-    // Move to the next node
-    ptr = ptr->_next;
-  }
-  // Set the pointer to the head of the set of links
-  ptr = cloud->_links->_head;
-  // Loop through the links
-  while (ptr != NULL) {
-    CloudGraphLink *link = (CloudGraphLink*)(ptr->_data);
-    // Create the bounding box
-    if (link->_boundingBox != NULL)
-      ShapoidFree(&(link->_boundingBox));
-    link->_boundingBox = BCurveGetBoundingBox(link->_curve);
-    // Add the bounding box to the set 
-    GSetAppend(set, link->_boundingBox);
-    // Move to the next link
-    ptr = ptr->_next;
+    node->_boundingBoxLbl._pos[0] = 
+      cols->_x[iNode] + cols->_rightX[iNode] * opt->_fontSizeNode;
+    node->_boundingBoxLbl._pos[1] = 
+      cols->_y[iNode] + cols->_rightY[iNode] * opt->_fontSizeNode;
   }
+  // Update the bounding boxes of the links, each thread on its own 
+  // range of links
+  CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+  int nbTask = CloudGraphSplitRanges(cloud, opt, opt->_nbThread, tasks);
+  CloudGraphRunTasks(CloudGraphLinkBoxesTask, tasks, nbTask);
   // Set the pointer to the head of the set of families
-  ptr = cloud->_families->_head;
+  GSetElem *ptr = cloud->_families->_head;
   // Loop through the families
   while (ptr != NULL) {
     CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
-    // Create the bounding box for the label
-    if (family->_boundingBox != NULL)
-      ShapoidFree(&(family->_boundingBox));
-    TGAFontSetRight(cloud->_font, family->_right);
-    family->_boundingBox = TGAFontGetStringBound(cloud->_font, 
-      (unsigned char*)(family->_label));
+    // Update the bounding box for the label
+    float width = 0.0;
+    float height = 0.0;
+    CloudGraphGetLabelMetric(cloud, family->_label, opt->_fontSizeNode, 
+      &width, &height);
+    CloudGraphSetLabelBound(&(family->_boundingBox), width, height, 
+      family->_right);
     // If the node labels are displayed
     if (opt->_nodeLabelMode != CloudGraphOptNodeLabelNone)
       // Correct the position of the family label
-      VecOp(family->_pos, 1.0, family->_right, 
-        maxLength + opt->_fontSizeNode);
+      for (int iDim = 2; iDim--;)
+        family->_pos[iDim] += 
+          family->_right[iDim] * (maxLength + opt->_fontSizeNode);
     // Place the bounding box for the label
-    VecCopy(family->_boundingBox->_pos, family->_pos);
-    // If the family labels are displayed
-    if (opt->_familyLabelMode != CloudGraphOptFamilyLabelNone)
-      // Add the label's bounding box to the set 
-      GSetAppend(set, family->_boundingBox);
+    for (int iDim = 2; iDim--;)
+      family->_boundingBox._pos[iDim] = family->_pos[iDim];
     // Move to the next family
     ptr = ptr->_next;
   }
+  // Update the whole bounding box
+  CloudGraphUnionBoundingBox(cloud, opt);
+}
+
+// Set the bounding box of the cloud from the bounding boxes of its 
+// nodes, links and families, without updating them
+// The bounds of the nodes and links are calculated using up to 
+// 'opt->_nbThread' threads, each on its own range, and then merged
+void CloudGraphUnionBoundingBox(CloudGraph *cloud, CloudGraphOpt *opt) {
+  // Get the bounds of the nodes and links, each thread on its own 
+  // range
+  CloudGraphRangeTask tasks[CLOUDGRAPH_MAXTHREAD];
+  int nbTask = CloudGraphSplitRanges(cloud, opt, opt->_nbThread, tasks);
+  CloudGraphRunTasks(CloudGraphBoundsTask, tasks, nbTask);
+  // Merge the bounds of the ranges
+  float min[2] = {FLT_MAX, FLT_MAX};
+  float max[2] = {-FLT_MAX, -FLT_MAX};
+  for (int iTask = 0; iTask < nbTask; ++iTask) {
+    for (int iDim = 2; iDim--;) {
+      if (tasks[iTask]._min[iDim] < min[iDim])
+        min[iDim] = tasks[iTask]._min[iDim];
+      if (tasks[iTask]._max[iDim] > max[iDim])
+        max[iDim] = tasks[iTask]._max[iDim];
+    }
+  }
+  // If the family labels are displayed
+  if (opt->_familyLabelMode != CloudGraphOptFamilyLabelNone) {
+    // Loop through the families
+    GSetElem *ptr = cloud->_families->_head;
+    while (ptr != NULL) {
+      CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
+      // Extend the bounds to the label's bounding box
+      CloudGraphExtendBounds(&(family->_boundingBox), min, max);
+      // Move to the next family
+      ptr = ptr->_next;
+    }
+  }
+  // If there is nothing in the cloud, its bounds are the origin
+  if (min[0] > max[0]) {
+    min[0] = min[1] = 0.0;
+    max[0] = max[1] = 0.0;
+  }
   // Create the whole bounding box
-  if (cloud->_boundingBox != NULL)
-    ShapoidFree(&(cloud->_boundingBox));
-  cloud->_boundingBox = ShapoidGetBoundingBox(set);
-  // Free the set
-  GSetFree(&set);
+  if (cloud->_boundingBox == NULL)
+    cloud->_boundingBox = FacoidCreate(2);
+  if (cloud->_boundingBox == NULL)
+    return;
   // Add some pixels to the border
   for (int iDim = 2; iDim--;) {
     VecSet(cloud->_boundingBox->_pos, iDim, 
-      VecGet(cloud->_boundingBox->_pos, iDim) - opt->_fontSizeNode);
+      min[iDim] - opt->_fontSizeNode);
     VecSet(cloud->_boundingBox->_axis[iDim], iDim, 
-      VecGet(cloud->_boundingBox->_axis[iDim], iDim) + 
-      opt->_fontSizeNode * 2.0);
+      max[iDim] - min[iDim] + opt->_fontSizeNode * 2.0);
+    VecSet(cloud->_boundingBox->_axis[iDim], 1 - iDim, 0.0);
+  }
+}
+
+// Get the bounds of the link at position 'iLink' in the columns of 
+// 'cloud' into 'min' and 'max' (2 floats each), from its bounding box
+// or, for a lazy link, from the extrema of its curve
+// Return false if the link has no bounds (lazy link toward an unknown
+// node), else return true
+bool CloudGraphGetLinkBounds(CloudGraph *cloud, int iLink, float *min, 
+  float *max) {
+  // Declare a pointer to the columns
+  CloudGraphColumns *cols = &(cloud->_cols);
+  CloudGraphLink *link = cols->_link[iLink];
+  // If the link is not lazy, get the bounds of its bounding box
+  if (link->_lazy == false) {
+    for (int iDim = 2; iDim--;) {
+      min[iDim] = FLT_MAX;
+      max[iDim] = -FLT_MAX;
+    }
+    CloudGraphExtendBounds(&(link->_boundingBox), min, max);
+    return true;
+  }
+  // Else get the bounds of the curve from the control points
+  int from = cols->_from[iLink];
+  int to = cols->_to[iLink];
+  if (from < 0 || to < 0)
+    return false;
+  float ctrl[8] = {cols->_x[from], cols->_y[from], 
+    cols->_c1x[iLink], cols->_c1y[iLink], 
+    cols->_c2x[iLink], cols->_c2y[iLink], 
+    cols->_x[to], cols->_y[to]};
+  CloudGraphGetCurveBounds(ctrl, min, max);
+  return true;
+}
+
+// Get the bounds of the cubic Bezier curve of control points 'ctrl' 
+// (4 points, x and y interleaved) into 'min' and 'max' (2 floats 
+// each), from the extrema of the curve
+// In each dimension the extrema are at the ends of the curve or where
+// its derivative, a polynomial of degree 2, is null, which is solved 
+// in closed form. The bounds are tighter than the control points, 
+// which the curve only approaches
+void CloudGraphGetCurveBounds(const float *ctrl, float *min, 
+  float *max) {
+  // Loop on the dimensions
+  for (int iDim = 2; iDim--;) {
+    double p0 = ctrl[iDim];
+    double p1 = ctrl[2 + iDim];
+    double p2 = ctrl[4 + iDim];
+    double p3 = ctrl[6 + iDim];
+    // Start with the ends of the curve
+    min[iDim] = (p0 < p3 ? p0 : p3);
+    max[iDim] = (p0 < p3 ? p3 : p0);
+    // Get the coefficients of the derivative, divided by 3:
+    // a.t^2 + b.t + c
+    double a = -p0 + 3.0 * p1 - 3.0 * p2 + p3;
+    double b = 2.0 * (p0 - 2.0 * p1 + p2);
+    double c = p1 - p0;
+    // Get the roots of the derivative
+    double root[2];
+    int nbRoot = 0;
+    if (fabs(a) < 1e-12 * (fabs(b) + fabs(c) + 1.0)) {
+      if (b != 0.0)
+        root[nbRoot++] = -c / b;
+    } else {
+      double delta = b * b - 4.0 * a * c;
+      if (delta >= 0.0) {
+        double sqrtDelta = sqrt(delta);
+        root[nbRoot++] = (-b + sqrtDelta) / (2.0 * a);
+        root[nbRoot++] = (-b - sqrtDelta) / (2.0 * a);
+      }
+    }
+    // Extend the bounds to the curve at the roots inside the curve
+    for (int iRoot = nbRoot; iRoot--;) {
+      double t = root[iRoot];
+      if (t <= 0.0 || t >= 1.0)
+        continue;
+      double u = 1.0 - t;
+      float v = u * u * u * p0 + 3.0 * u * u * t * p1 + 
+        3.0 * u * t * t * p2 + t * t * t * p3;
+      if (v < min[iDim])
+        min[iDim] = v;
+      if (v > max[iDim])
+        max[iDim] = v;
+    }
   }
 }
 
+// Update in place the bounding box of the link at position 'iLink' in
+// the columns of 'cloud' from the extrema of its curve
+// Do nothing for a lazy link, which has no bounding box
+void CloudGraphUpdateLinkBox(CloudGraph *cloud, int iLink) {
+  CloudGraphLink *link = cloud->_cols._link[iLink];
+  if (link->_lazy == true)
+    return;
+  // Get the bounds of the curve
+  float min[2];
+  float max[2];
+  CloudGraphGetCurveBounds(&(link->_ctrl[0][0]), min, max);
+  // Set the bounding box
+  CloudGraphBox *box = &(link->_boundingBox);
+  box->_pos[0] = min[0];
+  box->_pos[1] = min[1];
+  box->_axis[0][0] = max[0] - min[0];
+  box->_axis[0][1] = 0.0;
+  box->_axis[1][0] = 0.0;
+  box->_axis[1][1] = max[1] - min[1];
+}
+
 // Print the CloudGraph on 'stream'
 // Do nothing if arguments are invalid
 void CloudGraphPrint(CloudGraph *cloud, FILE* stream) {
@@ -1298,9 +8028,9 @@ void CloudGraphNodePrint(void *n, FILE *stream) {
   if (n == NULL || stream == NULL)
     return;
   // Print the node's properties
-  fprintf(stream, "#%d family(%d) ", 
-    ((CloudGraphNode*)n)->_id, ((CloudGraphNode*)n)->_family);
-  VecPrint(((CloudGraphNode*)n)->_pos, stream);
+  fprintf(stream, "#%d family(%d) <%.3f,%.3f>", 
+    ((CloudGraphNode*)n)->_id, ((CloudGraphNode*)n)->_family, 
+    ((CloudGraphNode*)n)->_pos[0], ((CloudGraphNode*)n)->_pos[1]);
   if (((CloudGraphNode*)n)->_label != NULL)
     fprintf(stream, " %s", ((CloudGraphNode*)n)->_label);
 }
@@ -1315,15 +8045,31 @@ void CloudGraphLinkPrint(void *l, FILE *stream) {
   fprintf(stream, "%03d-%03d", 
     ((CloudGraphLink*)l)->_nodes[0], 
     ((CloudGraphLink*)l)->_nodes[1]);
+  // Print the weight of bundles
+  if (((CloudGraphLink*)l)->_weight > 1)
+    fprintf(stream, "(x%d)", ((CloudGraphLink*)l)->_weight);
 }
 
 // Create a new CloudGraphOpt
-// Default _mode = CloudGraphModeFree
+// Default _mode = CloudGraphModeLine
 // Default _curvedLink = false
+// Default _curvature = 1.0
 // Default _nodeLabelMode = CloudGraphOptNodeLabelNone
 // Default _familyLabelMode = CloudGraphOptFamilyLabelNone
 // Default _fontSizeNode = 18
 // Default _fontSizeFamily = 22
+// Default _linkWeightMode = CloudGraphOptLinkWeightNone
+// Default _nodeOrder = CloudGraphOptNodeOrderNone
+// Default _nbThread = 1
+// Default _freeMaxIter = 300
+// Default _freeMaxTime = 0.0
+// Default _familyForce = 0.1
+// Default _maxCanvas = 4096
+// Default _glyphRotations = 0
+// Default _nodeSprite = false
+// Default _tiledRender = false
+// Default _linkRenderMode = CloudGraphOptLinkRenderCurve
+// Default _layoutCache = NULL
 // Return NULL if we couldn't create the CloudGraphOpt
 CloudGraphOpt* CloudGraphOptCreate(void) {
   // Allocate memory
@@ -1337,6 +8083,18 @@ CloudGraphOpt* CloudGraphOptCreate(void) {
     ret->_familyLabelMode = CloudGraphOptFamilyLabelNone;
     ret->_fontSizeNode = 18;
     ret->_fontSizeFamily = 22;
+    ret->_linkWeightMode = CloudGraphOptLinkWeightNone;
+    ret->_nodeOrder = CloudGraphOptNodeOrderNone;
+    ret->_nbThread = 1;
+    ret->_freeMaxIter = 300;
+    ret->_freeMaxTime = 0.0;
+    ret->_familyForce = 0.1;
+    ret->_maxCanvas = 4096;
+    ret->_glyphRotations = 0;
+    ret->_nodeSprite = false;
+    ret->_tiledRender = false;
+    ret->_linkRenderMode = CloudGraphOptLinkRenderCurve;
+    ret->_layoutCache = NULL;
   }
   return ret;
 }
@@ -1348,6 +8106,8 @@ void CloudGraphOptFree(CloudGraphOpt **opt) {
   if (opt == NULL || *opt == NULL)
     return;
   // Free memory
+  if ((*opt)->_layoutCache != NULL)
+    free((*opt)->_layoutCache);
   free(*opt);
   *opt = NULL;
 }
@@ -1414,6 +8174,138 @@ void CloudGraphOptSetFontSizeFamily(CloudGraphOpt *opt, float size) {
   opt->_fontSizeFamily = size;
 }
 
+// Set the mode of display for the weight of links to 'mode'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetLinkWeightMode(CloudGraphOpt *opt, 
+  CloudGraphOptLinkWeight mode) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Set the mode
+  opt->_linkWeightMode = mode;
+}
+
+// Set the mode of rendering of links to 'mode'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetLinkRenderMode(CloudGraphOpt *opt, 
+  CloudGraphOptLinkRender mode) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Set the mode
+  opt->_linkRenderMode = mode;
+}
+
+// Set the order of the nodes inside their family to 'order'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNodeOrder(CloudGraphOpt *opt, 
+  CloudGraphOptNodeOrder order) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Set the order
+  opt->_nodeOrder = order;
+}
+
+// Set the number of threads used to arrange the CloudGraph to 'nb'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNbThread(CloudGraphOpt *opt, int nb) {
+  // Check arguments
+  if (opt == NULL || nb < 1)
+    return;
+  // Set the number of threads
+  opt->_nbThread = nb;
+}
+
+// Set the budget of the free layout to 'maxIter' iterations and 
+// 'maxTime' seconds (0.0 for no time limit), the layout stops earlier
+// if it has converged
+// Do nothing if arguments are invalid
+void CloudGraphOptSetFreeBudget(CloudGraphOpt *opt, int maxIter, 
+  float maxTime) {
+  // Check arguments
+  if (opt == NULL || maxIter < 0 || maxTime < 0.0)
+    return;
+  // Set the budget
+  opt->_freeMaxIter = maxIter;
+  opt->_freeMaxTime = maxTime;
+}
+
+// Set the strength of the attraction of the nodes toward the center 
+// of their family in the free layout to 'force' (0.0 to disable it)
+// Do nothing if arguments are invalid
+void CloudGraphOptSetFamilyForce(CloudGraphOpt *opt, float force) {
+  // Check arguments
+  if (opt == NULL || force < 0.0)
+    return;
+  // Set the force
+  opt->_familyForce = force;
+}
+
+// Set the maximum width and height in pixels of the TGA in rings mode
+// to 'size' (in ]0.0, CLOUDGRAPH_MAXCANVAS])
+// Do nothing if arguments are invalid
+void CloudGraphOptSetMaxCanvas(CloudGraphOpt *opt, float size) {
+  // Check arguments
+  if (opt == NULL || size <= 0.0 || size > CLOUDGRAPH_MAXCANVAS)
+    return;
+  // Set the size
+  opt->_maxCanvas = size;
+}
+
+// Set the number of rotations of the glyphs of the node labels to 'nb'
+// (in [0, CLOUDGRAPH_MAXGLYPHROTATION])
+// Do nothing if arguments are invalid
+void CloudGraphOptSetGlyphRotations(CloudGraphOpt *opt, int nb) {
+  // Check arguments
+  if (opt == NULL || nb < 0 || nb > CLOUDGRAPH_MAXGLYPHROTATION)
+    return;
+  // Set the number of rotations
+  opt->_glyphRotations = nb;
+}
+
+// Set the flag memorizing if the disc of the nodes is rasterized once
+// and copied at each node to 'flag'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNodeSprite(CloudGraphOpt *opt, bool flag) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Set the flag
+  opt->_nodeSprite = flag;
+}
+
+// Set the flag memorizing if the TGA is rendered in tiles to 'flag'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetTiledRender(CloudGraphOpt *opt, bool flag) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Set the flag
+  opt->_tiledRender = flag;
+}
+
+// Set the directory of the layout cache to a copy of 'dir', or 
+// disable the cache if 'dir' is NULL
+// Do nothing if arguments are invalid or memory allocation failed
+void CloudGraphOptSetLayoutCache(CloudGraphOpt *opt, const char *dir) {
+  // Check arguments
+  if (opt == NULL)
+    return;
+  // Copy the directory
+  char *copy = NULL;
+  if (dir != NULL) {
+    copy = (char*)malloc(sizeof(char) * (strlen(dir) + 1));
+    if (copy == NULL)
+      return;
+    memcpy(copy, dir, sizeof(char) * (strlen(dir) + 1));
+  }
+  // Replace the current directory
+  if (opt->_layoutCache != NULL)
+    free(opt->_layoutCache);
+  opt->_layoutCache = copy;
+}
+
 // Return the length of the longest displayed node label
 // Return 0.0 of arguments are invalid or there is no displayed label
 float CloudGraphGetMaxLengthLblNode(CloudGraph *cloud, CloudGraphOpt *opt) {
@@ -1430,7 +8322,7 @@ float CloudGraphGetMaxLengthLblNode(CloudGraph *cloud, CloudGraphOpt *opt) {
     while (ptr != NULL) {
       CloudGraphNode *node = (CloudGraphNode*)(ptr->_data);
       // If the bounding box is larger than the current max length
-      float l = VecGet(node->_boundingBox->_axis[0], 0);
+      float l = node->_boundingBox._axis[0][0];
       if (l > maxLength)
         // Update the max length;
         maxLength = l;
@@ -1458,7 +8350,7 @@ float CloudGraphGetMaxLengthLblFamily(CloudGraph *cloud, CloudGraphOpt *opt) {
     while (ptr != NULL) {
       CloudGraphFamily *family = (CloudGraphFamily*)(ptr->_data);
       // If the bounding box is larger than the current max length
-      float l = VecGet(family->_boundingBox->_axis[0], 0);
+      float l = family->_boundingBox._axis[0][0];
       if (l > maxLength)
         // Update the max length;
         maxLength = l;
@@ -1471,46 +8363,22 @@ float CloudGraphGetMaxLengthLblFamily(CloudGraph *cloud, CloudGraphOpt *opt) {
 }
 
 // Return the node 'id' or NULL if arguments are invalid
+// The lookup uses the index of nodes, it is O(1)
 CloudGraphNode* CloudGraphGetNode(CloudGraph *cloud, int id) {
   // Check arguments
-  if (cloud == NULL)
+  if (cloud == NULL || id < 0 || id >= cloud->_nodeIndexSize)
     return NULL;
-  // Declare a pointer for the result
-  CloudGraphNode *res = NULL;
-  // Declare a pointer on the set of node
-  GSetElem *elem = cloud->_nodes->_head;
-  // Loop on node, stop when the node is found
-  while (elem != NULL && res == NULL) {
-    // If the current node is the searched node
-    if (((CloudGraphNode*)(elem->_data))->_id == id)
-      // Update the result
-      res = elem->_data;
-    // Move to next node
-    elem = elem->_next;
-  }
   // Return the result
-  return res;
+  return cloud->_nodeIndex[id];
 }
 
 // Return the family 'id' or NULL if arguments are invalid
-CloudGraphFamily* CloudGraphGetFamily(CloudGraph *cloud, int id) {
+// The lookup uses the index of families, it is O(1)
+CloudGraphFamily* CloudGraphGetFamily(const CloudGraph *cloud, int id) {
   // Check arguments
-  if (cloud == NULL)
+  if (cloud == NULL || id < 0 || id >= cloud->_familyIndexSize)
     return NULL;
-  // Declare a pointer for the result
-  CloudGraphFamily *res = NULL;
-  // Declare a pointer on the set of family
-  GSetElem *elem = cloud->_families->_head;
-  // Loop on node, stop when the family is found
-  while (elem != NULL && res == NULL) {
-    // If the current family is the searched family
-    if (((CloudGraphFamily*)(elem->_data))->_id == id)
-      // Update the result
-      res = elem->_data;
-    // Move to next family
-    elem = elem->_next;
-  }
   // Return the result
-  return res;
+  return cloud->_familyIndex[id];
 }
 
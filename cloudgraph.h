@@ -10,6 +10,7 @@
 #include <math.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "gset.h"
 #include "pbmath.h"
 #include "bcurve.h"
@@ -17,10 +18,38 @@
 
 // ================= Define ==================
 
-#define CG_NBMAXFAMILY 100
+// Version of the binary format of CloudGraphSaveBinary
+// All values are 32 bits little-endian integers
+// Header: "CGBF", version, nb families, nb nodes, nb links, size of the
+//   string pool in bytes, 2 reserved (0)
+// Families, for each: id, rgba (4 bytes), offset of the label in the
+//   string pool (0xFFFFFFFF if none)
+// Nodes, for each: id, family id, offset of the label in the string 
+//   pool (0xFFFFFFFF if none)
+// Links in compressed sparse rows, one row per node in the order of 
+//   the nodes: nb nodes + 1 offsets of the rows, nb links ids of the 
+//   second node of the links
+// String pool: the '\0' terminated labels
+#define CLOUDGRAPH_BINVERSION 1
+// Largest size in pixels of the TGA exported by CloudGraphToTGA, its 
+// dimensions are stored in a VecShort
+#define CLOUDGRAPH_MAXCANVAS 32767
+// Largest number of rotations of the glyphs of the node labels, see
+// CloudGraphOptSetGlyphRotations
+#define CLOUDGRAPH_MAXGLYPHROTATION 360
 
 // ================= Data structures ===================
 
+// Bounding box of a node, family label or link of the cloud, a 
+// parallelogram given by a corner and its two sides like a 2D Facoid, 
+// stored in the element itself
+typedef struct CloudGraphBox {
+  // Corner of the box
+  float _pos[2];
+  // Sides of the box from its corner
+  float _axis[2][2];
+} CloudGraphBox;
+
 // Node of the cloud
 typedef struct CloudGraphNode {
   // ID of the node
@@ -30,15 +59,25 @@ typedef struct CloudGraphNode {
   // Label of this node
   char *_label;
   // Position
-  VecFloat *_pos;
+  float _pos[2];
   // Bounding box of the node
-  Shapoid *_boundingBox;
+  CloudGraphBox _boundingBox;
   // Bounding box of the label
-  Shapoid *_boundingBoxLbl;
+  CloudGraphBox _boundingBoxLbl;
   // Vector indicating the right direction from this node
-  VecFloat *_right;
+  float _right[2];
   // Angle with the abciss 
   float _theta;
+  // Element of the set of nodes of the CloudGraph holding the node, 
+  // to remove it without searching the set
+  GSetElem *_elem;
+  // Size of the label before rotation measured at the font size 
+  // _labelSize, to place its bounding box without looking up the 
+  // cache of label metrics, _labelSize is 0.0 if the label has not 
+  // been measured yet and must be set back to 0.0 if _label changes
+  float _labelWidth;
+  float _labelHeight;
+  float _labelSize;
 } CloudGraphNode;
 
 // Family of the node
@@ -50,25 +89,218 @@ typedef struct CloudGraphFamily {
   // Label of this family
   char *_label;
   // Bounding box of the label
-  Shapoid *_boundingBox;
+  CloudGraphBox _boundingBox;
   // Position of the label
-  VecFloat *_pos;
+  float _pos[2];
   // Vector indicating the right direction of the label
-  VecFloat *_right;
+  float _right[2];
 } CloudGraphFamily;
 
 // Link of the CloudGraph
 typedef struct CloudGraphLink {
   // ID of the nodes
   int _nodes[2];
-  // BCurve to trace this link
-  BCurve *_curve;
-  // Bounding box of the link
-  Shapoid *_boundingBox;
+  // Control points of the cubic Bezier curve to trace this link, from
+  // the first node to the second one, not set if _lazy is true
+  float _ctrl[4][2];
+  // Bounding box of the link, not set if _lazy is true
+  CloudGraphBox _boundingBox;
+  // Flag set if the link was added to a CloudGraph with lazy links 
+  // (see CloudGraphSetLazyLinks)
+  bool _lazy;
   // ID of families (for color selection);
   int _families[2];
+  // Number of links between the same two nodes bundled in this link, 
+  // 1 if the link is not a bundle (see CloudGraphSetBundleLinks)
+  int _weight;
+  // Flag set if the link has been added since the last arrangement, 
+  // its geometry is then not set yet (see CloudGraphArrangeUpdate)
+  bool _dirty;
+  // Element of the set of links of the CloudGraph holding the link, 
+  // to remove it without searching the set
+  GSetElem *_elem;
+  // Position of the link in the columns of the CloudGraph holding it,
+  // to remove it without searching the columns, meaningful only while
+  // the columns are up to date
+  int _col;
 } CloudGraphLink;
 
+// Columnar copy of the nodes and links of a CloudGraph, in the order
+// of the arrangement, used by the arrange and render loops
+// Only what these loops read for every node and link is copied (IDs,
+// families, geometry, nodes of the links), in contiguous arrays, the
+// rest (labels, bounding boxes, curves) is read through _node and 
+// _link
+// The geometry in the columns is the reference while arranging, it is
+// copied at the end to the nodes and links whose fields are the 
+// layout seen by the callers (see CloudGraphPushColumns), and copied 
+// back from them when the columns are rebuilt or a layout is loaded 
+// from the cache (see CloudGraphPullColumns)
+// Arrays of nodes are indexed by the position of the node in the 
+// arrangement, arrays of links by the position of the link in the set
+// of links
+typedef struct CloudGraphColumns {
+  // Flag set if the columns reflect the nodes and links
+  bool _valid;
+  // Number of nodes and allocated size of the node arrays
+  int _nbNode;
+  int _capacityNode;
+  // Nodes
+  CloudGraphNode **_node;
+  // ID of the nodes
+  int *_id;
+  // ID of the family of the nodes
+  int *_family;
+  // Position of the nodes
+  float *_x;
+  float *_y;
+  // Right direction of the nodes
+  float *_rightX;
+  float *_rightY;
+  // Angle with the abciss of the nodes
+  float *_theta;
+  // Position in the node arrays of each node ID, -1 if unused
+  int *_col;
+  // Allocated size of _col
+  int _capacityCol;
+  // Number of links and allocated size of the link arrays
+  int _nbLink;
+  int _capacityLink;
+  // Links
+  CloudGraphLink **_link;
+  // Position in the node arrays of the two nodes of the links, -1 if 
+  // the node doesn't exist
+  int *_from;
+  int *_to;
+  // Intermediate control points of the links, the first and last ones
+  // are the position of the nodes
+  float *_c1x;
+  float *_c1y;
+  float *_c2x;
+  float *_c2y;
+  // Curvature used to set the intermediate control points in the last
+  // arrangement, used to set them again for links without curve when
+  // the columns are rebuilt
+  float _curvature;
+} CloudGraphColumns;
+
+// Adjacency of the nodes of a CloudGraph in compressed sparse rows, 
+// one row per node ID, the neighbors of the node 'id' are 
+// _neighbors[_offsets[id]] to _neighbors[_offsets[id] + _degree[id] 
+// - 1], and the row has room for _room[id] neighbors
+// Links are undirected, each link is in the rows of its two nodes, 
+// links toward unknown nodes are ignored, a bundle of links is one 
+// neighbor
+// It is built from the links at the first query, in the order of the 
+// rows, then kept up to date: an added link is appended to the rows 
+// of its two nodes, a full row being moved after the last row with 
+// twice its room, and a removed link is removed from the rows of its
+// two nodes
+// It is built again if a node is added while some links are toward 
+// unknown nodes, or the links are bundled or unbundled
+typedef struct CloudGraphAdjacency {
+  // Flag set if the adjacency reflects the nodes and links
+  bool _valid;
+  // Number of rows (greatest node ID + 1)
+  int _nbRow;
+  // Allocated size of _offsets, _degree and _room
+  int _capacityRow;
+  // Offsets of the rows in _neighbors
+  int *_offsets;
+  // Number of neighbors in the rows
+  int *_degree;
+  // Number of neighbors the rows have room for
+  int *_room;
+  // Number of links toward unknown nodes
+  int _nbIgnored;
+  // Size of _neighbors and _links used by the rows, the rows moved 
+  // because they were full leave unused room behind them
+  int _nbNeighbor;
+  // Allocated size of _neighbors and _links
+  int _capacityNeighbor;
+  // ID of the neighbors
+  int *_neighbors;
+  // Link toward each neighbor, in the same order as _neighbors
+  CloudGraphLink **_links;
+} CloudGraphAdjacency;
+
+// Hash set of the links of a CloudGraph bundling its links, keyed by
+// the unordered pair of their nodes, used to find the bundle of a 
+// link being added (see CloudGraphSetBundleLinks)
+// Open addressing with linear probing, the capacity is a power of 2 
+// and the set is kept at most half full
+typedef struct CloudGraphLinkSet {
+  // Number of links in the set
+  int _nb;
+  // Number of slots
+  int _capacity;
+  // Slots, NULL if empty
+  CloudGraphLink **_slots;
+} CloudGraphLinkSet;
+
+// Metrics of a label in the cache of label metrics
+typedef struct CloudGraphLabelMetric {
+  // Label, NULL if the slot is empty
+  // It is a copy in the arena of the CloudGraph, not the label of the
+  // node or family, and lives as long as the CloudGraph
+  const char *_label;
+  // Hash of the label and font size
+  uint64_t _hash;
+  // Font size of the metrics
+  float _size;
+  // Width and height of the bounding box of the label, before rotation
+  float _width;
+  float _height;
+} CloudGraphLabelMetric;
+
+// Hash map of the metrics of the labels of a CloudGraph, keyed by the
+// label and font size, the metrics don't depend on the right 
+// direction of the label so it is measured only once per font size
+// Open addressing with linear probing, the capacity is a power of 2 
+// and the map is kept at most half full
+typedef struct CloudGraphLabelCache {
+  // Number of metrics in the cache
+  int _nb;
+  // Number of slots
+  int _capacity;
+  // Slots
+  CloudGraphLabelMetric *_slots;
+} CloudGraphLabelCache;
+
+// Changes of a CloudGraph since its last arrangement, used by 
+// CloudGraphArrangeUpdate to process only these changes
+typedef struct CloudGraphDirty {
+  // Flag set if the layout and the columns reflect the last 
+  // arrangement and the changes below, it is unset by the changes 
+  // which can't be processed incrementally (bundling the links, ...) 
+  // and the next update is then a whole arrangement
+  bool _tracked;
+  // Flag set if nodes or families have been added or removed, or 
+  // links couldn't be tracked, since the last arrangement, the nodes 
+  // after them move so the next update places all the nodes and links
+  // again, but without sorting again the nodes already in order nor 
+  // measuring again their labels
+  bool _relayout;
+  // Number of links added since the last arrangement and allocated 
+  // size of _links
+  int _nbLink;
+  int _capacityLink;
+  // Position in the columns of the links added since the last 
+  // arrangement
+  int *_links;
+  // Bounds of the links removed since the last arrangement, to check 
+  // if the bounding box of the cloud may shrink
+  float _removedMin[2];
+  float _removedMax[2];
+} CloudGraphDirty;
+
+// Iterator on the neighbors of a node, see CloudGraphNeighborIterInit
+typedef struct CloudGraphNeighborIter {
+  // Current and end position in the neighbors of the node
+  const int *_cur;
+  const int *_end;
+} CloudGraphNeighborIter;
+
 // CloudGraph
 typedef struct CloudGraph {
   // SpringSys representing the CloudGraph
@@ -81,6 +313,66 @@ typedef struct CloudGraph {
   TGAFont *_font;
   // Bounding bos of the cloud
   Shapoid *_boundingBox;
+  // Index of the nodes by their ID, _nodeIndex[id] is the node 'id' 
+  // or NULL if there is no node with this ID
+  // It has one entry per ID up to the greatest one, so a sparse set of
+  // IDs costs memory proportional to the greatest ID
+  CloudGraphNode **_nodeIndex;
+  // Size of the index of nodes (greatest ID + 1)
+  int _nodeIndexSize;
+  // Allocated size of the index of nodes
+  int _nodeIndexCapacity;
+  // Index of the families by their ID, _familyIndex[id] is the family
+  // 'id' or NULL if there is no family with this ID
+  // It has one entry per ID up to the greatest one, so a sparse set of
+  // IDs costs memory proportional to the greatest ID
+  CloudGraphFamily **_familyIndex;
+  // Size of the index of families (greatest ID + 1)
+  int _familyIndexSize;
+  // Allocated size of the index of families
+  int _familyIndexCapacity;
+  // Memory mapping of the file loaded with CloudGraphLoadFile (NULL if
+  // none), the labels of nodes and families point into it
+  char *_map;
+  // Size in bytes of the memory mapping
+  size_t _mapSize;
+  // Columnar copy of the nodes and links for the arrange and render 
+  // loops (see CloudGraphColumns for which copy is the reference)
+  CloudGraphColumns _cols;
+  // Adjacency of the nodes, built from the links when first queried 
+  // (see CloudGraphGetNeighbors)
+  CloudGraphAdjacency _adj;
+  // Number of changes of the nodes, families, links and arrangement, 
+  // to detect the views which are out of date (see CloudGraphView)
+  unsigned int _generation;
+  // Arena serving the memory of the nodes, families, links and labels
+  // added to the CloudGraph, released at once by CloudGraphFree
+  struct CloudGraphArenaBlock *_arena;
+  // Blocks of the arena sorted by address, to find the block holding 
+  // a pointer by binary search
+  struct CloudGraphArenaBlock **_arenaBlocks;
+  // Number of blocks of the arena
+  int _nbArenaBlock;
+  // Allocated size of _arenaBlocks
+  int _capacityArenaBlock;
+  // Number of nodes, families and links of the CloudGraph allocated 
+  // outside of the arena (see CloudGraphTakeNode, ...), they are freed
+  // one by one by CloudGraphFree, which drops the arena without 
+  // walking the lists if there are none
+  int _nbOwned;
+  // Flag to memorize if the links are added without control points 
+  // and bounding box, their control points are then only in the 
+  // columns and their curve and bounds are computed when needed
+  bool _lazyLinks;
+  // Flag to memorize if the links between the same two nodes, in any
+  // direction, are bundled into one link
+  bool _bundleLinks;
+  // Set of the links, used only when bundling links
+  CloudGraphLinkSet _linkSet;
+  // Changes since the last arrangement
+  CloudGraphDirty _dirty;
+  // Metrics of the labels measured with _font
+  CloudGraphLabelCache _labelCache;
 } CloudGraph;
 
 // Modes of CloudGraph representation
@@ -88,7 +380,15 @@ typedef enum CloudGraphMode {
   // Default, Nodes are placed along a line
   CloudGraphModeLine,
   // Nodes are placed on the circumference of a circle
-  CloudGraphModeCircle
+  CloudGraphModeCircle,
+  // Nodes are placed by a force-directed layout: links attract their
+  // nodes, nodes repel each other and are attracted by the center of
+  // their family (see CloudGraphOptSetFreeBudget)
+  CloudGraphModeFree,
+  // Families are sub-circles placed on an outer ring, their nodes are 
+  // on concentric rings inside the sub-circle, and the layout is 
+  // scaled to fit the maximum canvas (see CloudGraphOptSetMaxCanvas)
+  CloudGraphModeRings
 } CloudGraphMode;
 
 // Modes of node's label representation
@@ -107,6 +407,39 @@ typedef enum CloudGraphOptFamilyLabel {
   CloudGraphOptFamilyLabelAll
 } CloudGraphOptFamilyLabel;
 
+// Modes of representation of the weight of links (number of links 
+// in a bundle, see CloudGraphSetBundleLinks)
+typedef enum CloudGraphOptLinkWeight {
+  // Default, all links are drawn the same
+  CloudGraphOptLinkWeightNone,
+  // The thickness of the links grows with the log of their weight
+  CloudGraphOptLinkWeightThickness,
+  // The opacity of the links is proportional to their weight
+  CloudGraphOptLinkWeightOpacity
+} CloudGraphOptLinkWeight;
+
+// Modes of rendering of the links
+typedef enum CloudGraphOptLinkRender {
+  // Default, each link is drawn as a curve
+  CloudGraphOptLinkRenderCurve,
+  // The links are flattened into the number of links crossing each 
+  // pixel, the opacity of a pixel is proportional to its number of 
+  // links and its color is the average color of its links
+  CloudGraphOptLinkRenderDensityLinear,
+  // As CloudGraphOptLinkRenderDensityLinear, but the opacity grows 
+  // with the log of the number of links
+  CloudGraphOptLinkRenderDensityLog
+} CloudGraphOptLinkRender;
+
+// Orders of the nodes of a family in the arrangement
+typedef enum CloudGraphOptNodeOrder {
+  // Default, order in which the nodes were added
+  CloudGraphOptNodeOrderNone,
+  // Decreasing number of neighbors (see CloudGraphGetDegree), nodes
+  // with the same degree in the order in which they were added
+  CloudGraphOptNodeOrderDegree
+} CloudGraphOptNodeOrder;
+
 // Graphical options while exporting to TGA
 typedef struct CloudGraphOpt {
   // Mode of CloudGraph representation
@@ -124,8 +457,56 @@ typedef struct CloudGraphOpt {
   float _fontSizeNode;
   // Font size for families
   float _fontSizeFamily;
+  // Mode for the weight of links
+  CloudGraphOptLinkWeight _linkWeightMode;
+  // Mode of rendering of links
+  CloudGraphOptLinkRender _linkRenderMode;
+  // Order of the nodes inside their family
+  CloudGraphOptNodeOrder _nodeOrder;
+  // Number of threads used to arrange the links and calculate the 
+  // bounding boxes, and to render the tiles if _tiledRender is true, 
+  // the result doesn't depend on it
+  int _nbThread;
+  // Maximum number of iterations of the free layout
+  int _freeMaxIter;
+  // Maximum duration in seconds of the free layout, 0.0 if unlimited
+  float _freeMaxTime;
+  // Strength of the attraction of the nodes toward the center of 
+  // their family in the free layout
+  float _familyForce;
+  // Maximum width and height in pixels of the TGA in rings mode
+  float _maxCanvas;
+  // Number of rotations at which the glyphs of the node labels are 
+  // rasterized once and then copied, 0 to draw each label with the 
+  // font
+  int _glyphRotations;
+  // Flag to rasterize the disc of the nodes once and copy it at each 
+  // node instead of drawing each node with the pencil
+  bool _nodeSprite;
+  // Flag to render the TGA in tiles drawn in parallel by _nbThread 
+  // threads instead of at once
+  bool _tiledRender;
+  // Directory of the layout cache, NULL if the cache is not used
+  // CloudGraphArrange reuses the layout saved in this directory for 
+  // the same graph and options instead of arranging again
+  char *_layoutCache;
 } CloudGraphOpt;
 
+// View of a CloudGraph rendered in a TGA, see CloudGraphToTGAView
+// The point (x, y) of the CloudGraph is drawn at the pixel 
+// ((x - _origin[0]) * _scale, (y - _origin[1]) * _scale)
+typedef struct CloudGraphView {
+  // Point of the CloudGraph at the origin of the TGA
+  float _origin[2];
+  // Number of pixels per unit of the CloudGraph
+  float _scale;
+  // Dimensions of the TGA in pixels
+  int _dim[2];
+  // Generation of the CloudGraph when the view was obtained (see 
+  // CloudGraph)
+  unsigned int _generation;
+} CloudGraphView;
+
 // ================ Functions declaration ====================
 
 // Create a new CloudGraph
@@ -170,7 +551,11 @@ bool CloudGraphCreateRnd(CloudGraph **cloud, int nbNodeMin,
 CloudGraphFamily* CloudGraphCreateFamily(void);
 
 // Add a copy of the family 'f' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
+// There is no limit on the number of families
+// The families are indexed by their ID, the memory of the index is 
+// proportional to the greatest ID, IDs should be dense
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed
 // else return true
 bool CloudGraphAddFamily(CloudGraph *cloud, CloudGraphFamily *f);
 
@@ -182,20 +567,102 @@ bool CloudGraphAddFamily(CloudGraph *cloud, CloudGraphFamily *f);
 CloudGraphNode* CloudGraphCreateNode(void);
 
 // Add a copy of the node 'n' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
+// The nodes are indexed by their ID, the memory of the index is 
+// proportional to the greatest ID, IDs should be dense
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed
 // else return true
 bool CloudGraphAddNode(CloudGraph *cloud, CloudGraphNode *n);
 
 // Create a CloudGraphLink with default values:
 // _nodes[0] = _nodes[1] = -1
+// _weight = 1
 // Return NULL if couldn't create the link
 CloudGraphLink* CloudGraphCreateLink(void);
 
 // Add a copy of the link 'l' to the CloudGraph
-// Return false if the arguments are invalid or memory allocation failed
-// else return true
+// If the CloudGraph bundles its links and already has a link between 
+// the same two nodes, the weight of 'l' is added to the weight of 
+// this link instead
+// Return false if the arguments are invalid (including a weight lower
+// than 1) or memory allocation failed, else return true
 bool CloudGraphAddLink(CloudGraph *cloud, CloudGraphLink *l);
 
+// Add the family '*f' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*f' is set to NULL
+// '*f' must have been created with CloudGraphCreateFamily and its
+// label, if any, allocated with malloc
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of '*f', else return true
+bool CloudGraphTakeFamily(CloudGraph *cloud, CloudGraphFamily **f);
+
+// Add the node '*n' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*n' is set to NULL
+// '*n' must have been created with CloudGraphCreateNode and its
+// label, if any, allocated with malloc
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the caller keeps the ownership of '*n', else return true
+bool CloudGraphTakeNode(CloudGraph *cloud, CloudGraphNode **n);
+
+// Add the link '*l' itself to the CloudGraph instead of a copy, the
+// CloudGraph takes ownership of it and '*l' is set to NULL
+// '*l' must have been created with CloudGraphCreateLink
+// If '*l' is bundled into a link already in the CloudGraph it is freed
+// Return false if the arguments are invalid or memory allocation 
+// failed, in which case the caller keeps the ownership of '*l', else 
+// return true
+bool CloudGraphTakeLink(CloudGraph *cloud, CloudGraphLink **l);
+
+// Add a copy of the 'nb' families 'f' to the CloudGraph, in the order
+// of the array
+// The memory for the copies and the index of families are reserved at
+// once for all the families
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the families before the one which couldn't be added stay in the
+// CloudGraph, else return true
+bool CloudGraphAddFamilies(CloudGraph *cloud, CloudGraphFamily **f,
+  int nb);
+
+// Add a copy of the 'nb' nodes 'n' to the CloudGraph, in the order of
+// the array
+// The memory for the copies and the index of nodes are reserved at
+// once for all the nodes
+// Return false if the arguments are invalid (including negative, 
+// INT_MAX or already used ID) or memory allocation failed, in which 
+// case the nodes before the one which couldn't be added stay in the
+// CloudGraph, else return true
+bool CloudGraphAddNodes(CloudGraph *cloud, CloudGraphNode **n, int nb);
+
+// Add a copy of the 'nb' links 'l' to the CloudGraph, in the order of
+// the array
+// The memory for the copies is reserved at once for all the links
+// Return false if the arguments are invalid or memory allocation
+// failed, in which case the links before the one which couldn't be
+// added stay in the CloudGraph, else return true
+bool CloudGraphAddLinks(CloudGraph *cloud, CloudGraphLink **l, int nb);
+
+// Remove the node 'id' and its links from the CloudGraph
+// Return false if arguments are invalid (including an unknown node)
+// else return true
+bool CloudGraphRemoveNode(CloudGraph *cloud, int id);
+
+// Remove one link between the nodes 'from' and 'to', in any 
+// direction, from the CloudGraph
+// If the link is a bundle of several links (see 
+// CloudGraphSetBundleLinks, bundles are kept when the CloudGraph 
+// stops bundling its links), its weight is decreased, else it is 
+// removed
+// The link is searched with the set of links if the CloudGraph 
+// bundles its links, else in the adjacency of 'from' (see 
+// CloudGraphGetNeighbors), and its position in the columns is the one
+// memorized in the link
+// Return false if arguments are invalid (including no link between 
+// the nodes), else return true
+bool CloudGraphRemoveLink(CloudGraph *cloud, int from, int to);
+
 // Load the CloudGraph from 'stream'
 // If 'cloud' is not NULL it is first freed
 // Return 0 on success
@@ -205,16 +672,106 @@ bool CloudGraphAddLink(CloudGraph *cloud, CloudGraphLink *l);
 // 4: fscanf error
 int CloudGraphLoad(CloudGraph **cloud, FILE *stream);
 
+// Load the CloudGraph from the file 'path' in the same text format as
+// CloudGraphLoad
+// The file is memory mapped and parsed in place, labels of nodes and 
+// families point into the mapping which is owned by the CloudGraph 
+// and released by CloudGraphFree
+// If 'cloud' is not NULL it is first freed
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: invalid data
+// 4: can't open or map the file, or unexpected end of file
+int CloudGraphLoadFile(CloudGraph **cloud, const char *path);
+
+// Load the CloudGraph from the file 'path' as CloudGraphLoadFile, and
+// parse the links section with 'nbThread' threads
+// The links section is split into chunks aligned on line returns, so 
+// each link must be on its own line
+// Return the same codes as CloudGraphLoadFile
+int CloudGraphLoadFileParallel(CloudGraph **cloud, const char *path, 
+  int nbThread);
+
+// Save the CloudGraph 'cloud' into the file 'path' in the binary 
+// format (see CLOUDGRAPH_BINVERSION)
+// Links are grouped by their first node, in the order of the nodes, 
+// a link is saved as many times as its weight
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: too large for the binary format, too many links counting the 
+// weights (INT_MAX) or too long labels in total (UINT32_MAX bytes)
+// 4: can't write the file
+int CloudGraphSaveBinary(CloudGraph *cloud, const char *path);
+
+// Load the CloudGraph from the file 'path' in the binary format saved
+// by CloudGraphSaveBinary
+// The file is memory mapped, labels of nodes and families point into 
+// its string pool, and the mapping is owned by the CloudGraph and 
+// released by CloudGraphFree
+// If 'cloud' is not NULL it is first freed
+// Return 0 on success
+// 1: invalid arguments
+// 2: can't allocate memory
+// 3: invalid data (including unknown magic number or version, and 
+// IDs of INT_MAX / 2 or more)
+// 4: can't open or map the file, or truncated file
+int CloudGraphLoadBinary(CloudGraph **cloud, const char *path);
+
 // Arrange the position of the nodes of the graph
+// If the layout cache of 'opt' is set, the layout is read from the 
+// cache when the graph and the options affecting the layout are the 
+// same as a previous arrangement, else it is saved in the cache
 // Return true if it could arrange nodes
 // Return false if arguments are invalid or it couldn't arrange nodes
 bool CloudGraphArrange(CloudGraph *cloud, CloudGraphOpt *opt);
 
+// Update the arrangement of the graph after nodes or links have been
+// added or removed since the last call to CloudGraphArrange or 
+// CloudGraphArrangeUpdate, 'opt' must be the options of this call
+// If only links have changed, only the control points and bounding 
+// box of the added links are calculated, and the bounding box of the
+// cloud is extended with them, or calculated again from the bounding 
+// boxes already calculated if a removed link was on its border
+// If nodes or families have changed, as the nodes are arranged by 
+// their rank in their family order, all the nodes and links are 
+// placed again, but the added nodes are merged in the order of the 
+// others instead of sorting all the nodes, the labels are not measured
+// again and the layout cache is not used
+// If the order of the nodes depends on the links (nodes ordered by 
+// their degree), or the position of the nodes depends on the links 
+// (CloudGraphModeFree), or the links have been bundled, the graph is
+// arranged again with CloudGraphArrange
+// Return true if it could arrange nodes
+// Return false if arguments are invalid or it couldn't arrange nodes
+bool CloudGraphArrangeUpdate(CloudGraph *cloud, CloudGraphOpt *opt);
+
 // Get a TGA picture representing the CloudGraph using the graphical
 // options 'opt'
-// Return NULL if we couldn't create the TGA
+// Return NULL if we couldn't create the TGA or if it would be larger
+// than CLOUDGRAPH_MAXCANVAS
 TGA* CloudGraphToTGA(CloudGraph *cloud, CloudGraphOpt *opt);
 
+// Get into 'view' the view of the whole CloudGraph 'cloud' at 'scale'
+// pixels per unit, ensuring the nodes and links are ready to be 
+// rendered by CloudGraphToTGAView
+// Return false if arguments are invalid, if memory allocation failed 
+// or if the TGA would be larger than CLOUDGRAPH_MAXCANVAS, else return
+// true
+bool CloudGraphGetView(CloudGraph *cloud, float scale, 
+  CloudGraphView *view);
+
+// Get a TGA picture representing the part 'view' of the CloudGraph 
+// using the graphical options 'opt'
+// The CloudGraph is not modified, several views of the same 
+// CloudGraph can be rendered at the same time
+// Return NULL if arguments are invalid, if the CloudGraph has been 
+// modified or arranged by the CloudGraph functions since 'view' was 
+// obtained with CloudGraphGetView, or if we couldn't create the TGA
+TGA* CloudGraphToTGAView(const CloudGraph *cloud, 
+  const CloudGraphOpt *opt, const CloudGraphView *view);
+
 // Print the CloudGraph on 'stream'
 // Do nothing if arguments are invalid
 void CloudGraphPrint(CloudGraph *cloud, FILE* stream);
@@ -232,13 +789,25 @@ void CloudGraphNodePrint(void *n, FILE *stream);
 void CloudGraphLinkPrint(void *l, FILE *stream);
 
 // Create a new CloudGraphOpt
-// Default _mode = CloudGraphModeFree
+// Default _mode = CloudGraphModeLine
 // Default _curvedLink = false
 // Default _curvature = 1.0
 // Default _nodeLabelMode = CloudGraphOptNodeLabelNone
 // Default _familyLabelMode = CloudGraphOptFamilyLabelNone
-// Default _fontSizeNode = 15
-// Default _fontSizeFamily = 18
+// Default _fontSizeNode = 18
+// Default _fontSizeFamily = 22
+// Default _linkWeightMode = CloudGraphOptLinkWeightNone
+// Default _nodeOrder = CloudGraphOptNodeOrderNone
+// Default _nbThread = 1
+// Default _freeMaxIter = 300
+// Default _freeMaxTime = 0.0
+// Default _familyForce = 0.1
+// Default _maxCanvas = 4096
+// Default _glyphRotations = 0
+// Default _nodeSprite = false
+// Default _tiledRender = false
+// Default _linkRenderMode = CloudGraphOptLinkRenderCurve
+// Default _layoutCache = NULL
 // Return NULL if we couldn't create the CloudGraphOpt
 CloudGraphOpt* CloudGraphOptCreate(void);
 
@@ -272,6 +841,87 @@ void CloudGraphOptSetFontSizeNode(CloudGraphOpt *opt, float size);
 // Do nothing if arguments are invalid
 void CloudGraphOptSetFontSizeFamily(CloudGraphOpt *opt, float size);
 
+// Set the mode of display for the weight of links to 'mode'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetLinkWeightMode(CloudGraphOpt *opt, 
+  CloudGraphOptLinkWeight mode);
+
+// Set the mode of rendering of links to 'mode'
+// The density modes are meant for graphs with too many links to draw 
+// them one by one, a link of weight w counts as w links if the weight
+// of links is displayed
+// Do nothing if arguments are invalid
+void CloudGraphOptSetLinkRenderMode(CloudGraphOpt *opt, 
+  CloudGraphOptLinkRender mode);
+
+// Set the order of the nodes inside their family to 'order'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNodeOrder(CloudGraphOpt *opt, 
+  CloudGraphOptNodeOrder order);
+
+// Set the number of threads used to arrange the CloudGraph to 'nb'
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNbThread(CloudGraphOpt *opt, int nb);
+
+// Set the budget of the free layout to 'maxIter' iterations and 
+// 'maxTime' seconds (0.0 for no time limit), the layout stops earlier
+// if it has converged
+// The layout doesn't depend on the number of threads, but it depends
+// on the speed of the computer if it is stopped by the time limit
+// Do nothing if arguments are invalid
+void CloudGraphOptSetFreeBudget(CloudGraphOpt *opt, int maxIter, 
+  float maxTime);
+
+// Set the strength of the attraction of the nodes toward the center 
+// of their family in the free layout to 'force' (0.0 to disable it)
+// Do nothing if arguments are invalid
+void CloudGraphOptSetFamilyForce(CloudGraphOpt *opt, float force);
+
+// Set the maximum width and height in pixels of the TGA in rings mode
+// to 'size' (in ]0.0, CLOUDGRAPH_MAXCANVAS]), the distance between 
+// nodes is reduced as needed but the labels keep their size
+// Do nothing if arguments are invalid
+void CloudGraphOptSetMaxCanvas(CloudGraphOpt *opt, float size);
+
+// Set the number of rotations of the glyphs of the node labels to 'nb'
+// (in [0, CLOUDGRAPH_MAXGLYPHROTATION])
+// Each glyph is rasterized once per rotation and copied in the labels
+// whose direction is the closest, the more rotations the closer to 
+// the font, 0 to draw each label with the font
+// It is faster but approximate: the directions are quantized and the
+// glyphs are placed at whole pixels, so the labels differ from the 
+// ones drawn with the font, which is the default
+// Do nothing if arguments are invalid
+void CloudGraphOptSetGlyphRotations(CloudGraphOpt *opt, int nb);
+
+// Set the flag memorizing if the disc of the nodes is rasterized once
+// and copied at each node to 'flag'
+// The disc is rasterized at a few subpixel positions and copied at the
+// closest one, false to draw each node with the pencil
+// It is faster but approximate: the center of the nodes is moved by 
+// up to 1/8 pixel, so the TGA differs from the one drawn with the 
+// pencil, which is the default
+// Do nothing if arguments are invalid
+void CloudGraphOptSetNodeSprite(CloudGraphOpt *opt, bool flag);
+
+// Set the flag memorizing if the TGA is rendered in tiles to 'flag'
+// The tiles are drawn in parallel by _nbThread threads, each in its 
+// own TGA whose origin is the corner of the tile
+// It is faster but approximate: the nodes, curves and labels are 
+// drawn by TGAPaint relative to the corner of the tile, so some pixels
+// differ by one unit of rounding from the TGA rendered at once, which
+// is the default (the links accumulated in density mode don't depend 
+// on the tiles)
+// Do nothing if arguments are invalid
+void CloudGraphOptSetTiledRender(CloudGraphOpt *opt, bool flag);
+
+// Set the directory of the layout cache to a copy of 'dir', or 
+// disable the cache if 'dir' is NULL
+// The cache files are named after the hash of the graph and options, 
+// and are in the byte order of the host
+// Do nothing if arguments are invalid or memory allocation failed
+void CloudGraphOptSetLayoutCache(CloudGraphOpt *opt, const char *dir);
+
 // Return the length of the longest displayed node label
 // Return 0.0 of arguments are invalid or there is no displayed label
 float CloudGraphGetMaxLengthLblNode(CloudGraph *cloud, CloudGraphOpt *opt);
@@ -281,9 +931,78 @@ float CloudGraphGetMaxLengthLblNode(CloudGraph *cloud, CloudGraphOpt *opt);
 float CloudGraphGetMaxLengthLblFamily(CloudGraph *cloud, CloudGraphOpt *opt);
 
 // Return the node 'id' or NULL if arguments are invalid
+// The lookup uses the index of nodes, it is O(1)
 CloudGraphNode* CloudGraphGetNode(CloudGraph *cloud, int id);
 
 // Return the family 'id' or NULL if arguments are invalid
-CloudGraphFamily* CloudGraphGetFamily(CloudGraph *cloud, int id);
+// The lookup uses the index of families, it is O(1)
+CloudGraphFamily* CloudGraphGetFamily(const CloudGraph *cloud, int id);
+
+// Get the number of nodes in the CloudGraph 'cloud'
+// Return 0 if arguments are invalid
+int CloudGraphGetNbNode(CloudGraph *cloud);
+
+// Get the number of links in the CloudGraph 'cloud'
+// Return 0 if arguments are invalid
+int CloudGraphGetNbLink(CloudGraph *cloud);
+
+// Get the position of the node 'id' into 'pos' (2 floats) and its 
+// right direction into 'right' (2 floats, may be NULL)
+// Return false if arguments are invalid, else return true
+bool CloudGraphGetNodeGeometry(CloudGraph *cloud, int id, float *pos, 
+  float *right);
+
+// Set the flag defining if the links added to the CloudGraph 'cloud' 
+// from now on are lazy to 'lazy'
+// Lazy links don't keep their control points nor their bounding box
+// (_ctrl and _boundingBox are not set), their control points are 
+// computed from the position of their nodes and the curvature when 
+// arranging, bounding and rendering
+// The flag is kept by the functions loading or creating a CloudGraph 
+// in place of 'cloud'
+// Do nothing if arguments are invalid
+void CloudGraphSetLazyLinks(CloudGraph *cloud, bool lazy);
+
+// Set the flag defining if the links of the CloudGraph 'cloud' 
+// between the same two nodes, in any direction, are bundled into one
+// link to 'bundle'
+// A bundle is the first of its links added to the CloudGraph, its 
+// weight is the total weight of its links, it is arranged and drawn 
+// once (see CloudGraphOptSetLinkWeightMode)
+// The links already in the CloudGraph are bundled when the flag is 
+// set, bundles stay as they are when it is unset
+// The flag is kept by the functions loading or creating a CloudGraph 
+// in place of 'cloud'
+// Return false if arguments are invalid or memory allocation failed,
+// in which case the flag is unchanged, else return true
+bool CloudGraphSetBundleLinks(CloudGraph *cloud, bool bundle);
+
+// Get the number of links between the node 'id' and other existing 
+// nodes of the CloudGraph 'cloud'
+// The adjacency is built in O(nb nodes + nb links) at the first 
+// query and then kept up to date when nodes and links are added or 
+// removed (see CloudGraphAdjacency), the lookup is O(1)
+// Return 0 if arguments are invalid or memory allocation failed
+int CloudGraphGetDegree(CloudGraph *cloud, int id);
+
+// Get the IDs of the neighbors of the node 'id', their number is set
+// into 'nb'
+// The returned array belongs to the CloudGraph and is valid until 
+// nodes or links are added or removed
+// The adjacency is built as in CloudGraphGetDegree
+// Return NULL if arguments are invalid or memory allocation failed
+const int* CloudGraphGetNeighbors(CloudGraph *cloud, int id, int *nb);
+
+// Set the iterator 'iter' on the neighbors of the node 'id'
+// The iterator is valid until nodes or links are added or removed
+// Return false if arguments are invalid or memory allocation failed, 
+// else return true
+bool CloudGraphNeighborIterInit(CloudGraph *cloud, int id, 
+  CloudGraphNeighborIter *iter);
+
+// Get the ID of the next neighbor of the iterator 'iter' into 'id'
+// Return false if there is no more neighbor or arguments are invalid,
+// else return true
+bool CloudGraphNeighborIterNext(CloudGraphNeighborIter *iter, int *id);
 
 #endif
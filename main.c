@@ -26,11 +26,15 @@ int main(int argc, char **argv) {
   char flagPrint = 0;
   char *fileNameTGA = NULL;
   char *fileNameGraph = NULL;
+  char *fileNameGraphBin = NULL;
+  char *fileNameSaveBin = NULL;
   int nbNodeMin = 5;
   int nbNodeMax = 20;
   int nbFamilyMin = 1;
   int nbFamilyMax = 5;
   float density = 0.1;
+  int nbThread = 1;
+  float scale = 1.0;
   CloudGraphMode mode = CloudGraphModeLine;
   // Declare a variable for the graphical options when exporting to TGA
   CloudGraphOpt *opt = CloudGraphOptCreate();
@@ -59,6 +63,30 @@ int main(int argc, char **argv) {
       mode = CloudGraphModeCircle;
     } else if (strcmp(argv[iArg] , "-line") == 0) {
       mode = CloudGraphModeLine;
+    } else if (strcmp(argv[iArg] , "-free") == 0) {
+      mode = CloudGraphModeFree;
+    } else if (strcmp(argv[iArg] , "-rings") == 0) {
+      mode = CloudGraphModeRings;
+    } else if (strcmp(argv[iArg] , "-maxCanvas") == 0 && 
+      iArg + 1 < argc) {
+      CloudGraphOptSetMaxCanvas(opt, atof(argv[iArg + 1]));
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-scale") == 0 && iArg + 1 < argc) {
+      scale = atof(argv[iArg + 1]);
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-glyphRotations") == 0 && 
+      iArg + 1 < argc) {
+      CloudGraphOptSetGlyphRotations(opt, atoi(argv[iArg + 1]));
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-nodeSprite") == 0) {
+      CloudGraphOptSetNodeSprite(opt, true);
+    } else if (strcmp(argv[iArg] , "-tiles") == 0) {
+      CloudGraphOptSetTiledRender(opt, true);
+    } else if (strcmp(argv[iArg] , "-freeBudget") == 0 && 
+      iArg + 2 < argc) {
+      CloudGraphOptSetFreeBudget(opt, atoi(argv[iArg + 1]), 
+        atof(argv[iArg + 2]));
+      iArg += 2;
     } else if (strcmp(argv[iArg] , "-nodeLabel") == 0) {
       CloudGraphOptSetNodeLabelMode(opt, CloudGraphOptNodeLabelAll);
     } else if (strcmp(argv[iArg] , "-familyLabel") == 0) {
@@ -66,6 +94,45 @@ int main(int argc, char **argv) {
     } else if (strcmp(argv[iArg] , "-file") == 0 && iArg + 1 < argc) {
       fileNameGraph = argv[iArg + 1];
       ++iArg;
+    } else if (strcmp(argv[iArg] , "-fileBin") == 0 && iArg + 1 < argc) {
+      fileNameGraphBin = argv[iArg + 1];
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-saveBin") == 0 && iArg + 1 < argc) {
+      fileNameSaveBin = argv[iArg + 1];
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-cache") == 0 && iArg + 1 < argc) {
+      CloudGraphOptSetLayoutCache(opt, argv[iArg + 1]);
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-lazyLinks") == 0) {
+      CloudGraphSetLazyLinks(cloud, true);
+    } else if (strcmp(argv[iArg] , "-bundle") == 0) {
+      CloudGraphSetBundleLinks(cloud, true);
+    } else if (strcmp(argv[iArg] , "-linkWeight") == 0 && 
+      iArg + 1 < argc) {
+      if (strcmp(argv[iArg + 1] , "thickness") == 0)
+        CloudGraphOptSetLinkWeightMode(opt, 
+          CloudGraphOptLinkWeightThickness);
+      else if (strcmp(argv[iArg + 1] , "opacity") == 0)
+        CloudGraphOptSetLinkWeightMode(opt, 
+          CloudGraphOptLinkWeightOpacity);
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-density") == 0 && 
+      iArg + 1 < argc) {
+      if (strcmp(argv[iArg + 1] , "linear") == 0)
+        CloudGraphOptSetLinkRenderMode(opt, 
+          CloudGraphOptLinkRenderDensityLinear);
+      else if (strcmp(argv[iArg + 1] , "log") == 0)
+        CloudGraphOptSetLinkRenderMode(opt, 
+          CloudGraphOptLinkRenderDensityLog);
+      ++iArg;
+    } else if (strcmp(argv[iArg] , "-orderDegree") == 0) {
+      CloudGraphOptSetNodeOrder(opt, CloudGraphOptNodeOrderDegree);
+    } else if (strcmp(argv[iArg] , "-threads") == 0 && iArg + 1 < argc) {
+      nbThread = atoi(argv[iArg + 1]);
+      if (nbThread < 1)
+        nbThread = 1;
+      CloudGraphOptSetNbThread(opt, nbThread);
+      ++iArg;
     } else if (strcmp(argv[iArg] , "-rnd") == 0 && iArg + 5 < argc) {
       nbNodeMin = atoi(argv[iArg + 1]);
       nbNodeMax = atoi(argv[iArg + 2]);
@@ -75,12 +142,20 @@ int main(int argc, char **argv) {
       iArg += 5;
     } else if (strcmp(argv[iArg] , "-help") == 0) {
       printf("arguments : [-tga <filename>] [-print]");
-      printf(" [-file <filename>] [-free] [-circle] [-line]");
+      printf(" [-file <filename>] [-fileBin <filename>]");
+      printf(" [-saveBin <filename>] [-threads <nb>]");
+      printf(" [-cache <directory>] [-lazyLinks]");
+      printf(" [-bundle] [-linkWeight <thickness|opacity>]");
+      printf(" [-orderDegree] [-density <linear|log>]");
+      printf(" [-free] [-circle] [-line] [-rings]");
+      printf(" [-maxCanvas <pixels>] [-scale <pixels per unit>]");
+      printf(" [-freeBudget <maxIter> <maxSeconds>]");
       printf(" [-rnd <nbNodeMin> <nbNodeMax> <nbFamilyMin>");
       printf(" <nbFamilyMax> <density>]");
-      printf(" <-nodeLabel> <-familyLabel>");
+      printf(" <-nodeLabel> <-familyLabel> [-glyphRotations <nb>]");
+      printf(" [-nodeSprite] [-tiles]");
       printf(" [-curved <curvature in [0.0,1.0]>]\n");
-      printf("if -rnd and -file are both omitted, uses ");
+      printf("if -rnd, -file and -fileBin are omitted, uses ");
       printf("'-rnd %d %d %d %d %f' by default\n", nbNodeMin, nbNodeMax, 
         nbFamilyMin, nbFamilyMax, density);
       // Stop here
@@ -91,8 +166,23 @@ int main(int argc, char **argv) {
   }
   // Set the mode
   CloudGraphOptSetMode(opt, mode);
-  // If there is no input file
-  if (fileNameGraph == NULL) {
+  // If there is a binary input file
+  if (fileNameGraphBin != NULL) {
+    // Load the binary input file
+    int ret = CloudGraphLoadBinary(&cloud, fileNameGraphBin);
+    // If we couldn't load the CloudGraph
+    if (ret != 0) {
+      // Display a message
+      fprintf(stderr, 
+        "Error while loading the binary CloudGraph file (%d)\n", ret);
+      // Free the memory
+      CloudGraphFree(&cloud);
+      CloudGraphOptFree(&opt);
+      // Stop here
+      return 1;
+    }
+  // Else, if there is no input file
+  } else if (fileNameGraph == NULL) {
     // Create a random graph
     bool ret = CloudGraphCreateRnd(&cloud, nbNodeMin, 
       nbNodeMax, nbFamilyMin, nbFamilyMax, density);
@@ -110,8 +200,8 @@ int main(int argc, char **argv) {
   // Else there is a input file
   } else {
     // Load the input file
-    FILE *stream = fopen(fileNameGraph, "r");
-    int ret = CloudGraphLoad(&cloud, stream);
+    int ret = CloudGraphLoadFileParallel(&cloud, fileNameGraph, 
+      nbThread);
     // If we couldn't load the CloudGraph
     if (ret != 0) {
       // Display a message
@@ -123,7 +213,20 @@ int main(int argc, char **argv) {
       // Stop here
       return 1;
     }
-    fclose(stream);
+  }
+  // If the CloudGraph must be saved in binary format
+  if (fileNameSaveBin != NULL) {
+    int ret = CloudGraphSaveBinary(cloud, fileNameSaveBin);
+    if (ret != 0) {
+      // Display a message
+      fprintf(stderr, 
+        "Error while saving the binary CloudGraph file (%d)\n", ret);
+      // Free the memory
+      CloudGraphFree(&cloud);
+      CloudGraphOptFree(&opt);
+      // Stop here
+      return 1;
+    }
   }
   // Arrange the CloudGraph
   bool ret = CloudGraphArrange(cloud, opt);
@@ -138,8 +241,12 @@ int main(int argc, char **argv) {
   }
   // If there is a output TGA file
   if (fileNameTGA != NULL) {
-    // Save the result in the TGA picture
-    TGA *tga = CloudGraphToTGA(cloud, opt);
+    // Save the result in the TGA picture, viewing the whole graph at 
+    // the requested scale
+    CloudGraphView view;
+    TGA *tga = NULL;
+    if (CloudGraphGetView(cloud, scale, &view) == true)
+      tga = CloudGraphToTGAView(cloud, opt, &view);
     if (tga == NULL) {
       // Display a message
       fprintf(stderr, "Error while exporting to TGA\n");